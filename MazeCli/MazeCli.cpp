@@ -0,0 +1,405 @@
+// maze-cli: headless generate / solve / stats / bench / bot sim, no window or audio
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "Maze.h"
+#include "MazeGen.h"
+#include "MazeSolve.h"
+#include "MazeHpa.h"
+#include "MazeBot.h"
+#include "MazeBench.h"
+#include "Rng.h"
+
+using namespace std;
+
+// -------------------- OPTIONS --------------------
+struct CliOptions {
+    vector<int> sizes;        // square sizes (bench) ...
+    int width = DEFAULT_MAZE_W, height = DEFAULT_MAZE_H; // ... or one WxH board
+    int gen = GEN_STACK;
+    GenOptions genOptions;    // --gt-policy / --gt-newest
+    bool allGens = false;
+    uint64_t seed = 0;
+    bool seedGiven = false;
+    int count = 1;
+    int threads = 0;          // 0 = all cores
+    double seconds = 1.0;
+    string in, out = "-";
+    bool show = false;        // solve: print the board with the path
+    bool latency = false;     // bench: single-thread table
+    bool scaling = false;     // bench: tiled generator thread scaling
+    bool field = false;       // bench: goal distance field build cost
+    bool bitbfs = false;      // bench: scalar vs bit-parallel BFS
+    bool multibfs = false;    // bench: 64-source BFS vs 64 single runs
+    bool search = false;      // bench: BFS vs A* vs JPS point queries
+    bool hpa = false;         // bench: hierarchical search
+    int cluster = HPA_DEFAULT_CLUSTER;
+    bool graph = false;       // bench: junction graph vs cell-level search
+    bool alt = false;         // bench: landmark distance oracle
+    int bot = -1;             // sim: one bot level, -1 = all
+    bool prune = false;       // sim: wall follower skips dead branches
+    bool swarm = false;       // bench: chaser swarm ticks/s
+    bool repair = false;      // bench: goal field repair vs rebuild
+    bool shift = false;       // bench: shifting walls cost per tick
+    int ring = 0;             // stream: rows buffered between generator thread and writer, 0 = none
+};
+
+void printUsage() {
+    cout <<
+        "usage: maze-cli <command> [options]\n"
+        "  gen    --size WxH --algo ID --seed N --count N --out FILE|-\n"
+        "  solve  (--in FILE | gen options) [--show]\n"
+        "  stats  (--in FILE | gen options)\n"
+        "  bench  --algo ID|all --size N[,N...] --threads N --seconds S [--latency] [--scaling] [--field] [--bitbfs] [--multibfs] [--search]\n"
+        "         [--hpa [--cluster N]] [--graph] [--alt] [--swarm] [--repair] [--shift]\n"
+        "  sim    (--in FILE | gen options) [--bot LEVEL|all] [--prune]\n"
+        "  stream WIDTH HEIGHT FILE|- [--seed N] [--ring ROWS]\n"
+        "  check  [--algo ID|all]   incremental field repairs against fresh searches, eller stream ring\n"
+        "algorithms:";
+    for (int g = 0; g < GEN_COUNT; g++) cout << " " << MAZE_GENERATORS[g].id;
+    cout << "\ngrowing-tree: --gt-policy";
+    for (int p = 0; p < GT_POLICY_COUNT; p++) cout << (p ? "|" : " ") << GT_POLICY_IDS[p];
+    cout << " (default " << GT_POLICY_IDS[GenOptions().treePolicy] << "), --gt-newest PERCENT for mixed (default "
+        << GenOptions().treeNewestPercent << "); bench and check use the defaults";
+    cout << "\nbot levels:";
+    for (int l = 0; l < BOT_LEVEL_COUNT; l++) cout << " " << BOT_LEVELS[l].id;
+    cout << "\n";
+}
+
+bool parseOptions(int argc, char* argv[], int first, CliOptions& opt) {
+    for (int i = first; i < argc; i++) {
+        string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--size" && hasValue) {
+            // "31x21" or a comma list of square sizes "31,1023,8191"
+            string value = argv[++i];
+            size_t start = 0;
+            opt.sizes.clear();
+            while (start <= value.size()) {
+                size_t comma = value.find(',', start);
+                string part = value.substr(start, comma == string::npos ? string::npos : comma - start);
+                int w, h;
+                if (!parseMazeSize(part, w, h)) { cerr << "bad --size " << value << endl; return false; }
+                opt.width = w; opt.height = h;
+                opt.sizes.push_back(w);
+                if (comma == string::npos) break;
+                start = comma + 1;
+            }
+        }
+        else if (arg == "--algo" && hasValue) {
+            string id = argv[++i];
+            opt.allGens = (id == "all");
+            if (!opt.allGens) {
+                opt.gen = findGenerator(id);
+                if (opt.gen < 0) { cerr << "unknown --algo " << id << endl; return false; }
+            }
+        }
+        // growing-tree tuning, recorded on every maze it makes
+        else if (arg == "--gt-policy" && hasValue) {
+            string id = argv[++i];
+            int policy = findGrowingTreePolicy(id);
+            if (policy < 0) { cerr << "unknown --gt-policy " << id << endl; return false; }
+            opt.genOptions.treePolicy = policy;
+        }
+        else if (arg == "--gt-newest" && hasValue) {
+            int percent = atoi(argv[++i]);
+            if (percent < 0 || percent > 100) { cerr << "--gt-newest wants 0..100" << endl; return false; }
+            opt.genOptions.treeNewestPercent = percent;
+        }
+        else if (arg == "--seed" && hasValue) { opt.seed = strtoull(argv[++i], nullptr, 10); opt.seedGiven = true; }
+        else if (arg == "--count" && hasValue) opt.count = atoi(argv[++i]);
+        else if (arg == "--threads" && hasValue) opt.threads = atoi(argv[++i]);
+        else if (arg == "--seconds" && hasValue) opt.seconds = atof(argv[++i]);
+        else if (arg == "--in" && hasValue) opt.in = argv[++i];
+        else if (arg == "--out" && hasValue) opt.out = argv[++i];
+        else if (arg == "--show") opt.show = true;
+        else if (arg == "--latency") opt.latency = true;
+        else if (arg == "--scaling") opt.scaling = true;
+        else if (arg == "--field") opt.field = true;
+        else if (arg == "--bitbfs") opt.bitbfs = true;
+        else if (arg == "--multibfs") opt.multibfs = true;
+        else if (arg == "--search") opt.search = true;
+        else if (arg == "--hpa") opt.hpa = true;
+        else if (arg == "--graph") opt.graph = true;
+        else if (arg == "--alt") opt.alt = true;
+        else if (arg == "--swarm") opt.swarm = true;
+        else if (arg == "--repair") opt.repair = true;
+        else if (arg == "--shift") opt.shift = true;
+        else if (arg == "--prune") opt.prune = true;
+        else if (arg == "--cluster" && hasValue) opt.cluster = atoi(argv[++i]);
+        else if (arg == "--ring" && hasValue) opt.ring = atoi(argv[++i]);
+        else if (arg == "--bot" && hasValue) {
+            string id = argv[++i];
+            opt.bot = (id == "all") ? -1 : findBotLevel(id);
+            if (id != "all" && opt.bot < 0) { cerr << "unknown --bot " << id << endl; return false; }
+        }
+        else { cerr << "unknown option " << arg << endl; return false; }
+    }
+    if (!opt.seedGiven) opt.seed = randomSeed();
+    return true;
+}
+
+// Calls fn for every maze: read from --in, or generated from the options
+template <typename Fn>
+bool forEachMaze(const CliOptions& opt, Fn fn) {
+    Maze maze;
+    if (!opt.in.empty()) {
+        ifstream fin(opt.in);
+        if (!fin) { cerr << "cannot open " << opt.in << endl; return false; }
+        int index = 0;
+        while (readMazeText(fin, maze)) fn(index++, maze);
+        if (index == 0) { cerr << "no mazes in " << opt.in << endl; return false; }
+        return true;
+    }
+    maze.resize(opt.width, opt.height);
+    for (int i = 0; i < opt.count; i++) {
+        generateMaze(maze, opt.gen, opt.seed + i, opt.genOptions);
+        fn(i, maze);
+    }
+    return true;
+}
+
+// -------------------- COMMANDS --------------------
+int cmdGen(const CliOptions& opt) {
+    ofstream file;
+    if (opt.out != "-") {
+        file.open(opt.out, ios::trunc | ios::binary);
+        if (!file) { cerr << "cannot open " << opt.out << endl; return 1; }
+    }
+    ostream& out = (opt.out == "-") ? cout : file;
+
+    auto t0 = chrono::steady_clock::now();
+    forEachMaze(opt, [&](int, const Maze& maze) { writeMazeText(out, maze); });
+    double secs = chrono::duration<double>(chrono::steady_clock::now() - t0).count();
+    cerr << "generated " << opt.count << " " << MAZE_GENERATORS[opt.gen].id << " maze(s) "
+        << clampMazeSize(opt.width) << "x" << clampMazeSize(opt.height) << " from seed " << opt.seed
+        << " in " << secs << " s" << endl;
+    return out ? 0 : 1;
+}
+
+void showMaze(const Maze& maze, const vector<int>& path) {
+    vector<char> board((size_t)maze.width * maze.height);
+    for (int y = 0; y < maze.height; y++)
+        for (int x = 0; x < maze.width; x++) board[(size_t)y * maze.width + x] = maze.isWall(x, y) ? '#' : ' ';
+    for (size_t i = 0; i < path.size(); i++) board[path[i]] = '.';
+    board[(size_t)maze.startY * maze.width + maze.startX] = 'S';
+    board[(size_t)maze.goalY * maze.width + maze.goalX] = 'G';
+    for (int y = 0; y < maze.height; y++) {
+        cout.write(&board[(size_t)y * maze.width], maze.width);
+        cout << "\n";
+    }
+}
+
+int cmdSolve(const CliOptions& opt) {
+    bool allSolved = true;
+    bool ok = forEachMaze(opt, [&](int index, const Maze& maze) {
+        vector<int> path;
+        auto t0 = chrono::steady_clock::now();
+        int length = solveMaze(maze, &path);
+        double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - t0).count();
+        cout << "maze " << index << ": " << maze.width << "x" << maze.height << " seed " << maze.seed;
+        if (length < 0) { cout << " unsolvable" << endl; allSolved = false; return; }
+        cout << " solution " << length << " steps (" << ms << " ms)" << endl;
+        if (opt.show) showMaze(maze, path);
+    });
+    return (ok && allSolved) ? 0 : 1;
+}
+
+int cmdStats(const CliOptions& opt) {
+    MazeStats total;
+    int mazes = 0;
+    long long solutionSum = 0;
+    printf("%6s %12s %10s %10s %10s %8s %12s %10s %8s\n", "maze", "open", "deadends", "junctions", "corridors", "loops",
+        "deadbranch", "solution", "turns");
+    bool ok = forEachMaze(opt, [&](int index, const Maze& maze) {
+        MazeStats s = computeMazeStats(maze);
+        printf("%6d %12lld %10lld %10lld %10lld %8lld %12lld %10d %8d%s\n", index, s.openCells, s.deadEnds, s.junctions,
+            s.corridors, s.loops, s.deadBranchCells, s.solutionLength, s.solutionTurns, s.connected ? "" : "  (not connected)");
+        total.openCells += s.openCells; total.deadEnds += s.deadEnds;
+        total.junctions += s.junctions; total.corridors += s.corridors;
+        total.deadBranchCells += s.deadBranchCells;
+        solutionSum += s.solutionLength;
+        mazes++;
+    });
+    if (!ok || mazes == 0) return 1;
+    printf("avg: dead ends %.2f%%, junctions %.2f%%, corridors %.2f%%, dead branches %.2f%% of open cells, solution %.1f steps\n",
+        100.0 * total.deadEnds / total.openCells, 100.0 * total.junctions / total.openCells,
+        100.0 * total.corridors / total.openCells, 100.0 * total.deadBranchCells / total.openCells, (double)solutionSum / mazes);
+    return 0;
+}
+
+int cmdBench(const CliOptions& opt) {
+    if (opt.latency) { runGeneratorBenchmark(); return 0; }
+    if (opt.scaling) { runParallelScalingBenchmark(opt.sizes.empty() ? 8191 : opt.sizes[0]); return 0; }
+    if (opt.field) {
+        vector<int> sizes = opt.sizes;
+        if (sizes.empty()) sizes = { 31, 255, 1023, 2047, 4095, 8191 };
+        runDistanceFieldBenchmark(sizes, opt.gen, opt.seconds);
+        return 0;
+    }
+    if (opt.bitbfs) {
+        vector<int> sizes = opt.sizes;
+        if (sizes.empty()) sizes = { 255, 1023, 2047, 4095 };
+        runBitBfsBenchmark(sizes, opt.gen, opt.seconds);
+        return 0;
+    }
+    if (opt.multibfs) {
+        vector<int> sizes = opt.sizes;
+        if (sizes.empty()) sizes = { 255, 1023, 2047 };
+        runMultiBfsBenchmark(sizes, opt.gen, opt.seconds);
+        return 0;
+    }
+    if (opt.search) {
+        vector<int> sizes = opt.sizes;
+        if (sizes.empty()) sizes = { 31, 255, 1023, 2047, 4095, 8191 };
+        runSearchBenchmark(sizes, opt.gen, opt.seconds);
+        return 0;
+    }
+    if (opt.hpa) {
+        vector<int> sizes = opt.sizes;
+        if (sizes.empty()) sizes = { 1023, 2047, 4095, 8191 };
+        runHpaBenchmark(sizes, opt.gen, opt.cluster, opt.threads, opt.seconds);
+        return 0;
+    }
+    if (opt.graph) {
+        vector<int> sizes = opt.sizes;
+        if (sizes.empty()) sizes = { 255, 1023, 2047, 4095 };
+        runJunctionGraphBenchmark(sizes, opt.gen, opt.seconds);
+        return 0;
+    }
+    if (opt.alt) {
+        vector<int> sizes = opt.sizes;
+        if (sizes.empty()) sizes = { 255, 1023, 2047 };
+        runLandmarkBenchmark(sizes, opt.gen, opt.threads, opt.seconds);
+        return 0;
+    }
+    if (opt.swarm) {
+        // --size picks the board, 512 by default (rounded to 511)
+        runSwarmBenchmark(opt.sizes.empty() ? 512 : opt.sizes[0], { 0, 100, 1000, 10000 }, opt.gen, opt.seconds);
+        return 0;
+    }
+    if (opt.repair) {
+        vector<int> sizes = opt.sizes;
+        if (sizes.empty()) sizes = { 255, 1023, 2047 };
+        runRepairBenchmark(sizes, opt.gen, opt.seconds);
+        return 0;
+    }
+    if (opt.shift) {
+        vector<int> sizes = opt.sizes;
+        if (sizes.empty()) sizes = { 255, 1023, 2047 };
+        runShiftBenchmark(sizes, opt.gen, opt.seconds);
+        return 0;
+    }
+
+    vector<int> sizes = opt.sizes;
+    if (sizes.empty()) sizes = { 31, 255, 1023 };
+    printf("%-16s %8s %8s %10s %12s %12s\n", "generator", "size", "threads", "mazes", "mazes/s", "Mcells/s");
+    for (int g = 0; g < GEN_COUNT; g++) {
+        if (!opt.allGens && g != opt.gen) continue;
+        for (size_t i = 0; i < sizes.size(); i++) {
+            if (g == GEN_SIMPLE && sizes[i] > 255) continue; // quadratic
+            runThroughputBenchmark(g, sizes[i], opt.threads, opt.seconds);
+        }
+    }
+    return 0;
+}
+
+// Every bot level races each maze alone from start to goal, the same
+// 60 ticks per second as the game; fails if some bot never gets there
+int cmdSim(const CliOptions& opt) {
+    static const int dx[4] = { 0, 0, -1, 1 };
+    static const int dy[4] = { -1, 1, 0, 0 };
+    struct LevelTotals { long long ticks = 0, moves = 0, optimal = 0, mistakes = 0, failed = 0; double tickNs = 0; };
+    vector<LevelTotals> totals(BOT_LEVEL_COUNT);
+    int mazes = 0;
+    bool ok = forEachMaze(opt, [&](int index, const Maze& maze) {
+        DistanceField toGoal;
+        toGoal.buildToGoal(maze);
+        int optimal = toGoal.at(maze.startX, maze.startY);
+        if (optimal < 0) return;
+        mazes++;
+        JunctionGraph graph;
+        if (opt.prune) {
+            graph.build(maze);
+            graph.findDeadBranches();
+        }
+        for (int l = 0; l < BOT_LEVEL_COUNT; l++) {
+            if (opt.bot >= 0 && l != opt.bot) continue;
+            const BotLevel& lv = BOT_LEVELS[l];
+            long long limit = (2LL * maze.width * maze.height + 16) * (lv.moveTicks + lv.reactionTicks + 1);
+
+            MazeBot bot;
+            bot.reset(l, opt.seed + index);
+            int x = maze.startX, y = maze.startY;
+            long long ticks = 0;
+            auto t0 = chrono::steady_clock::now();
+            while ((x != maze.goalX || y != maze.goalY) && ticks < limit) {
+                int d = bot.tick(maze, toGoal, x, y, opt.prune ? &graph : nullptr);
+                if (d >= 0 && maze.isOpen(x + dx[d], y + dy[d])) { x += dx[d]; y += dy[d]; }
+                ticks++;
+            }
+            double ns = chrono::duration<double, nano>(chrono::steady_clock::now() - t0).count();
+
+            LevelTotals& t = totals[l];
+            if (x != maze.goalX || y != maze.goalY) t.failed++;
+            t.ticks += ticks; t.moves += bot.moves(); t.optimal += optimal; t.mistakes += bot.mistakes();
+            t.tickNs += ns / max(ticks, 1LL);
+        }
+    });
+    if (!ok || mazes == 0) return 1;
+
+    printf("%d maze(s) %dx%d\n", mazes, clampMazeSize(opt.width), clampMazeSize(opt.height));
+    printf("%-10s %12s %10s %12s %10s %8s %10s\n", "bot", "seconds", "moves", "vs shortest", "mistakes", "failed", "ns/tick");
+    bool allFinished = true;
+    for (int l = 0; l < BOT_LEVEL_COUNT; l++) {
+        if (opt.bot >= 0 && l != opt.bot) continue;
+        const LevelTotals& t = totals[l];
+        printf("%-10s %12.1f %10.0f %11.2fx %10.1f %8lld %10.1f\n", BOT_LEVELS[l].id, t.ticks / 60.0 / mazes, (double)t.moves / mazes,
+            (double)t.moves / max(t.optimal, 1LL), (double)t.mistakes / mazes, t.failed, t.tickNs / mazes);
+        if (t.failed) allFinished = false;
+    }
+    return allFinished ? 0 : 1;
+}
+
+int cmdCheck(const CliOptions& opt) {
+    bool ok = true;
+    for (int g = 0; g < GEN_COUNT; g++) {
+        if (!opt.allGens && g != opt.gen) continue;
+        printf("generator %s\n", MAZE_GENERATORS[g].id);
+        if (!runRepairChecks(g)) ok = false;
+    }
+    if (opt.allGens || opt.gen == GEN_ELLER) {
+        printf("eller stream\n");
+        if (!runStreamChecks()) ok = false;
+    }
+    return ok ? 0 : 1;
+}
+
+// -------------------- MAIN --------------------
+int main(int argc, char* argv[]) {
+    if (argc < 2) { printUsage(); return 1; }
+    string cmd = argv[1];
+
+    if (cmd == "stream") {
+        if (argc < 5) { printUsage(); return 1; }
+        CliOptions opt;
+        if (!parseOptions(argc, argv, 5, opt)) return 1;
+        return runEllerStreamToFile(atoi(argv[2]), atoll(argv[3]), argv[4], opt.seed, opt.ring) ? 0 : 1;
+    }
+
+    CliOptions opt;
+    if (!parseOptions(argc, argv, 2, opt)) { printUsage(); return 1; }
+    if (cmd == "gen") return cmdGen(opt);
+    if (cmd == "solve") return cmdSolve(opt);
+    if (cmd == "stats") return cmdStats(opt);
+    if (cmd == "bench") return cmdBench(opt);
+    if (cmd == "sim") return cmdSim(opt);
+    if (cmd == "check") return cmdCheck(opt);
+
+    printUsage();
+    return 1;
+}
@@ -0,0 +1,110 @@
+#include "Maze.h"
+#include <bit>
+#include <cstdlib>
+#include <istream>
+#include <ostream>
+#include <sstream>
+
+using namespace std;
+
+void Maze::resize(int w, int h) {
+    width = clampMazeSize(w);
+    height = clampMazeSize(h);
+    rowWords = (width + 63) / 64;
+    bits.resize((size_t)rowWords * height);
+    // a reused grid keeps the old board's bits; whatever sits past the new
+    // width must read as wall again (countOpen and the bit searches rely on it)
+    uint64_t padding = ~lastWordMask();
+    for (int y = 0; y < height; y++) row(y)[rowWords - 1] |= padding;
+
+    startX = 1; startY = 1;
+    goalX = width - 2; goalY = height - 2;
+}
+
+void Maze::fillAllWithWalls() {
+    // padding bits are walls too, so a plain fill is enough
+    for (size_t i = 0; i < bits.size(); i++) bits[i] = ~0ull;
+}
+
+void Maze::fillRow(int y, bool wall) {
+    uint64_t* r = row(y);
+    for (int i = 0; i < rowWords; i++) r[i] = wall ? ~0ull : 0;
+    if (!wall) r[rowWords - 1] = ~lastWordMask(); // keep padding as wall
+}
+
+long long Maze::countOpen() const {
+    long long walls = 0;
+    for (size_t i = 0; i < bits.size(); i++) walls += std::popcount(bits[i]);
+    // padding bits count as walls, take them back out
+    long long padding = (long long)height * ((long long)rowWords * 64 - width);
+    return (long long)width * height - (walls - padding);
+}
+
+int clampMazeSize(int n) {
+    if (n < MIN_MAZE_SIZE) n = MIN_MAZE_SIZE;
+    if (n > MAX_MAZE_SIZE) n = MAX_MAZE_SIZE;
+    if (n % 2 == 0) n++; // walls on even rows/cols, so size has to be odd
+    if (n > MAX_MAZE_SIZE) n -= 2;
+    return n;
+}
+
+bool parseMazeSize(const string& arg, int& w, int& h) {
+    size_t xPos = arg.find_first_of("xX");
+    w = atoi(arg.substr(0, xPos).c_str());
+    h = (xPos == string::npos) ? w : atoi(arg.substr(xPos + 1).c_str());
+    return w > 0 && h > 0;
+}
+
+// -------------------- TEXT FORMAT --------------------
+void appendMazeRows(string& out, const Maze& maze) {
+    for (int y = 0; y < maze.height; y++) {
+        for (int x = 0; x < maze.width; x++) out += maze.isWall(x, y) ? '1' : '0';
+        out += '\n';
+    }
+}
+
+bool readMazeRows(istream& in, Maze& maze) {
+    string row;
+    for (int y = 0; y < maze.height; y++) {
+        if (!(in >> row) || (int)row.size() < maze.width) return false;
+        // start from a wall row, whatever the grid held before
+        maze.fillRow(y, true);
+        for (int x = 0; x < maze.width; x++) if (row[x] == '0') maze.setWall(x, y, false);
+    }
+    return true;
+}
+
+void writeMazeText(ostream& out, const Maze& maze) {
+    string text;
+    text.reserve((size_t)(maze.width + 1) * maze.height + 64);
+    text += string(MAZE_FILE_TAG) + " " + to_string(maze.width) + " " + to_string(maze.height) + " "
+        + to_string(maze.seed) + " " + to_string(maze.generator) + " "
+        + to_string(maze.options.treePolicy) + " " + to_string(maze.options.treeNewestPercent) + "\n";
+    text += to_string(maze.startX) + " " + to_string(maze.startY) + " "
+        + to_string(maze.goalX) + " " + to_string(maze.goalY) + "\n";
+    appendMazeRows(text, maze);
+    out << text;
+}
+
+bool readMazeText(istream& in, Maze& maze) {
+    string tag;
+    int w, h, gen, sx, sy, gx, gy;
+    uint64_t seed;
+    if (!(in >> tag) || tag != MAZE_FILE_TAG) return false;
+    // the options came later: a header without them used the defaults
+    string header;
+    getline(in, header);
+    istringstream fields(header);
+    GenOptions options;
+    if (!(fields >> w >> h >> seed >> gen)) return false;
+    int policy, percent;
+    if (fields >> policy >> percent) { options.treePolicy = policy; options.treeNewestPercent = percent; }
+    if (!(in >> sx >> sy >> gx >> gy)) return false;
+    if (clampMazeSize(w) != w || clampMazeSize(h) != h) return false;
+
+    maze.resize(w, h);
+    if (!maze.inGrid(sx, sy) || !maze.inGrid(gx, gy)) return false;
+    maze.startX = sx; maze.startY = sy; maze.goalX = gx; maze.goalY = gy;
+    maze.seed = seed; maze.generator = gen; maze.options = options;
+    return readMazeRows(in, maze);
+}
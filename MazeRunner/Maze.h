@@ -0,0 +1,93 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+// Default board size (cells live on odd coordinates, walls in between)
+const int DEFAULT_MAZE_W = 31;
+const int DEFAULT_MAZE_H = 31;
+const int MIN_MAZE_SIZE = 5;
+const int MAX_MAZE_SIZE = 16383;
+
+// Generator settings that change the maze a seed gives. Only the growing
+// tree has any; they travel with the maze (and its file header) so a shared
+// seed always rebuilds the same board.
+struct GenOptions {
+    int treePolicy = 3;           // GT_MIXED, see MazeGen.h
+    int treeNewestPercent = 75;   // mixed policy: chance of the newest cell
+    bool operator==(const GenOptions&) const = default;
+};
+
+// Runtime-sized maze grid, one bit per cell: 1 means wall, 0 means open.
+// Each row starts on a fresh 64-bit word; the unused bits past the right edge
+// are kept at 1 so a row word can be treated as "wall mask" without masking,
+// and ~word is the open mask.
+struct Maze {
+    int width = 0;
+    int height = 0;
+    int rowWords = 0;              // 64-bit words per row
+    std::vector<uint64_t> bits;    // row-major, height * rowWords
+
+    // Start and goal
+    int startX = 1, startY = 1;
+    int goalX = 1, goalY = 1;
+
+    // How it was made: size + generator + seed + options recreate the same maze
+    uint64_t seed = 0;
+    int generator = -1;
+    GenOptions options;
+
+    // Sets the size and puts start/goal in opposite corners. Storage is only
+    // reallocated when the new board is bigger than anything seen before;
+    // cells are left as they were (fill or write every row next), padding
+    // past the width is always wall.
+    void resize(int w, int h);
+    void fillAllWithWalls();
+
+    bool inGrid(int x, int y) const { return (unsigned)x < (unsigned)width && (unsigned)y < (unsigned)height; }
+    bool insideBounds(int x, int y) const { return x > 0 && x < width - 1 && y > 0 && y < height - 1; }
+
+    bool isWall(int x, int y) const {
+        return (bits[(size_t)y * rowWords + (x >> 6)] >> (x & 63)) & 1;
+    }
+    void setWall(int x, int y, bool wall) {
+        uint64_t& w = bits[(size_t)y * rowWords + (x >> 6)];
+        uint64_t m = 1ull << (x & 63);
+        if (wall) w |= m; else w &= ~m;
+    }
+
+    // used by movement checks: bounds + wall test, no allocation
+    bool isOpen(int x, int y) const { return inGrid(x, y) && !isWall(x, y); }
+
+    // Word-wide row access (rowWords words, bit x&63 of word x>>6 is cell x)
+    uint64_t* row(int y) { return &bits[(size_t)y * rowWords]; }
+    const uint64_t* row(int y) const { return &bits[(size_t)y * rowWords]; }
+
+    // Bits of the last word in a row that are real cells
+    uint64_t lastWordMask() const { return (width & 63) ? ((1ull << (width & 63)) - 1) : ~0ull; }
+
+    void fillRow(int y, bool wall);
+    long long countOpen() const;
+    size_t memoryBytes() const { return bits.size() * sizeof(uint64_t); }
+};
+
+// Turns a requested size into a valid one: odd, clamped to [MIN, MAX]
+int clampMazeSize(int n);
+
+// "31" or "31x21"
+bool parseMazeSize(const std::string& arg, int& w, int& h);
+
+// -------------------- TEXT FORMAT --------------------
+// Rows are lines of '0'/'1', one char per cell (also used by the save file).
+void appendMazeRows(std::string& out, const Maze& maze);
+bool readMazeRows(std::istream& in, Maze& maze); // maze already sized
+
+// Standalone maze file, several can be concatenated into one pool file:
+//   MAZE w h seed generator treePolicy treeNewestPercent
+//   startX startY goalX goalY
+//   rows...
+const char* const MAZE_FILE_TAG = "MAZE";
+void writeMazeText(std::ostream& out, const Maze& maze);
+bool readMazeText(std::istream& in, Maze& maze); // false at end of input; older headers end at generator
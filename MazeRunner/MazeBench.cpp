@@ -0,0 +1,840 @@
+#include "MazeBench.h"
+#include "Maze.h"
+#include "MazeGen.h"
+#include "MazeStream.h"
+#include "MazeParallel.h"
+#include "MazeSolve.h"
+#include "MazeBitBfs.h"
+#include "MazeSearch.h"
+#include "MazeHpa.h"
+#include "MazeGraph.h"
+#include "MazeLandmarks.h"
+#include "MazeSwarm.h"
+#include "MazeBot.h"
+#include "MazeRepair.h"
+#include "MazeShift.h"
+#include "Rng.h"
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+
+using namespace std;
+
+// Seconds per size to spend on each generator (at least one run)
+const double BENCH_SECONDS = 0.5;
+
+double secondsSince(chrono::steady_clock::time_point t0) {
+    return chrono::duration<double>(chrono::steady_clock::now() - t0).count();
+}
+
+void runGeneratorBenchmark() {
+    const int sizes[] = { 31, 255, 1023, 2047 };
+
+    printf("%-16s %8s %10s %12s %12s\n", "generator", "size", "runs", "ms/maze", "Mcells/s");
+    for (int g = 0; g < GEN_COUNT; g++) {
+        for (int size : sizes) {
+            // the old rescan generator is quadratic, skip the big boards
+            if (g == GEN_SIMPLE && size > 255) continue;
+
+            Maze maze;
+            maze.resize(size, size);
+            int runs = 0;
+            auto t0 = chrono::steady_clock::now();
+            do {
+                generateMaze(maze, g, (uint64_t)runs + 1);
+                runs++;
+            } while (secondsSince(t0) < BENCH_SECONDS);
+            double secs = secondsSince(t0);
+
+            double cells = (double)maze.width * maze.height * runs;
+            printf("%-16s %8d %10d %12.3f %12.2f\n", MAZE_GENERATORS[g].id, size, runs,
+                secs * 1000.0 / runs, cells / secs / 1e6);
+        }
+    }
+}
+
+double runThroughputBenchmark(int gen, int size, int threads, double seconds) {
+    if (threads <= 0) threads = (int)thread::hardware_concurrency();
+    if (threads <= 0) threads = 1;
+
+    atomic<long long> made(0);
+    atomic<bool> stop(false);
+    auto worker = [&](int id) {
+        Maze maze;
+        maze.resize(size, size);
+        // seeds interleave across workers so no two mazes share one
+        for (uint64_t i = id; !stop; i += threads) {
+            generateMaze(maze, gen, i + 1);
+            made++;
+        }
+    };
+
+    auto t0 = chrono::steady_clock::now();
+    vector<thread> pool;
+    for (int i = 0; i < threads; i++) pool.emplace_back(worker, i);
+    while (secondsSince(t0) < seconds) this_thread::sleep_for(chrono::milliseconds(10));
+    stop = true;
+    for (size_t i = 0; i < pool.size(); i++) pool[i].join();
+    double secs = secondsSince(t0);
+
+    double rate = made / secs;
+    int w = clampMazeSize(size);
+    printf("%-16s %8d %8d %10lld %12.1f %12.2f\n", MAZE_GENERATORS[gen].id, w, threads, (long long)made,
+        rate, rate * w * w / 1e6);
+    return rate;
+}
+
+void runParallelScalingBenchmark(int size) {
+    Maze maze;
+    maze.resize(size, size);
+    int cores = (int)thread::hardware_concurrency();
+    if (cores < 1) cores = 1;
+
+    printf("\ntiled generator, %dx%d, %d core(s)\n", maze.width, maze.height, cores);
+    printf("%8s %12s %10s\n", "threads", "ms/maze", "speedup");
+    double baseMs = 0;
+    for (int threads = 1; ; threads *= 2) {
+        if (threads > cores) threads = cores;
+        auto t0 = chrono::steady_clock::now();
+        generateMazeTiled(maze, threads, 12345);
+        double ms = secondsSince(t0) * 1000.0;
+        if (threads == 1) baseMs = ms;
+        printf("%8d %12.1f %9.2fx\n", threads, ms, baseMs / ms);
+        if (threads == cores) break;
+    }
+}
+
+void runDistanceFieldBenchmark(const vector<int>& sizes, int gen, double seconds) {
+    printf("%8s %10s %12s %12s %12s %10s\n", "size", "builds", "ms/build", "Mcells/s", "lookup ns", "MB");
+    for (int size : sizes) {
+        Maze maze;
+        maze.resize(size, size);
+        generateMaze(maze, gen, 1);
+
+        DistanceField field;
+        int runs = 0;
+        auto t0 = chrono::steady_clock::now();
+        do {
+            field.buildToGoal(maze);
+            runs++;
+        } while (secondsSince(t0) < seconds);
+        double secs = secondsSince(t0);
+
+        // per-frame cost: steps left plus a hint from a random open cell
+        Rng rng(2);
+        const int LOOKUPS = 1000000;
+        long long sum = 0;
+        auto t1 = chrono::steady_clock::now();
+        for (int i = 0; i < LOOKUPS; i++) {
+            int x = 1 + 2 * (int)rng.below((uint32_t)cellsWide(maze));
+            int y = 1 + 2 * (int)rng.below((uint32_t)cellsHigh(maze));
+            int nx = x, ny = y;
+            sum += field.at(x, y) + field.nextStep(x, y, nx, ny);
+        }
+        double lookupNs = secondsSince(t1) * 1e9 / LOOKUPS;
+        if (sum == 42) printf(" ");
+
+        double cells = (double)maze.width * maze.height;
+        printf("%8d %10d %12.3f %12.2f %12.1f %10.1f\n", maze.width, runs, secs * 1000.0 / runs,
+            cells * runs / secs / 1e6, lookupNs, field.memoryBytes() / 1048576.0);
+    }
+}
+
+// Runs fn until `seconds` have passed (at least once), returns ms per run
+template <typename Fn>
+double timePerRun(double seconds, Fn fn) {
+    int runs = 0;
+    auto t0 = chrono::steady_clock::now();
+    do { fn(); runs++; } while (secondsSince(t0) < seconds);
+    return secondsSince(t0) * 1000.0 / runs;
+}
+
+void runBitBfsBenchmark(const vector<int>& sizes, int gen, double seconds) {
+#if defined(__AVX2__)
+    printf("bit-parallel BFS (AVX2 dense sweeps), generator %s\n", MAZE_GENERATORS[gen].id);
+#else
+    printf("bit-parallel BFS (portable dense sweeps), generator %s\n", MAZE_GENERATORS[gen].id);
+#endif
+    printf("%8s %10s %10s %10s %8s %10s %8s\n", "size", "layers", "scalar ms", "reach ms", "speedup", "dist ms", "speedup");
+    for (int size : sizes) {
+        Maze maze;
+        maze.resize(size, size);
+        generateMaze(maze, gen, 1);
+
+        vector<int> dist;
+        BitBfs bfs;
+        double scalarMs = timePerRun(seconds, [&] { bfsDistances(maze, maze.goalX, maze.goalY, dist); });
+        double reachMs = timePerRun(seconds, [&] { bfs.run(maze, maze.goalX, maze.goalY); });
+        double distMs = timePerRun(seconds, [&] { bfs.run(maze, maze.goalX, maze.goalY, &dist); });
+
+        printf("%8d %10d %10.2f %10.2f %7.1fx %10.2f %7.1fx\n", maze.width, bfs.layers(), scalarMs,
+            reachMs, scalarMs / reachMs, distMs, scalarMs / distMs);
+    }
+}
+
+void runMultiBfsBenchmark(const vector<int>& sizes, int gen, double seconds) {
+    // 16 targets: the batch stops once every pair is known; 64 targets is
+    // close to the whole 64 x 64 matrix, i.e. every source's full BFS
+    printf("64 sources x 16 / 64 targets, generator %s\n", MAZE_GENERATORS[gen].id);
+    printf("%8s %12s %12s %12s %8s %12s %8s\n", "size", "64x scalar", "64x bit", "x16 ms", "speedup", "x64 ms", "speedup");
+    for (int size : sizes) {
+        Maze maze;
+        maze.resize(size, size);
+        generateMaze(maze, gen, 1);
+
+        // random room cells (odd coordinates are always open)
+        Rng rng(3);
+        vector<GridPos> sources(MULTI_BFS_LANES), targets(16), allTargets(MULTI_BFS_LANES);
+        for (auto& p : sources) p = { 1 + 2 * (int)rng.below(cellsWide(maze)), 1 + 2 * (int)rng.below(cellsHigh(maze)) };
+        for (auto& p : targets) p = { 1 + 2 * (int)rng.below(cellsWide(maze)), 1 + 2 * (int)rng.below(cellsHigh(maze)) };
+        for (auto& p : allTargets) p = { 1 + 2 * (int)rng.below(cellsWide(maze)), 1 + 2 * (int)rng.below(cellsHigh(maze)) };
+
+        vector<int> dist, matrix;
+        BitBfs bfs;
+        double scalarMs = timePerRun(seconds, [&] {
+            for (auto& p : sources) bfsDistances(maze, p.x, p.y, dist);
+        });
+        double bitMs = timePerRun(seconds, [&] {
+            for (auto& p : sources) bfs.run(maze, p.x, p.y, &dist);
+        });
+        double multiMs = timePerRun(seconds, [&] { multiSourceDistances(maze, sources, targets, matrix); });
+        double fullMs = timePerRun(seconds, [&] { multiSourceDistances(maze, sources, allTargets, matrix); });
+
+        printf("%8d %12.2f %12.2f %12.2f %7.1fx %12.2f %7.1fx\n", maze.width, scalarMs, bitMs, multiMs, scalarMs / multiMs,
+            fullMs, scalarMs / fullMs);
+    }
+}
+
+void runSearchBenchmark(const vector<int>& sizes, int gen, double seconds) {
+    const char* names[3] = { "bfs", "astar", "jps" };
+    printf("random cell pairs, generator %s\n", MAZE_GENERATORS[gen].id);
+    printf("%8s %6s %8s %14s %12s %10s\n", "size", "algo", "queries", "expanded/query", "us/query", "MB");
+    for (int size : sizes) {
+        Maze maze;
+        maze.resize(size, size);
+        generateMaze(maze, gen, 1);
+
+        Rng rng(4);
+        vector<GridPos> pairs(64);
+        for (auto& p : pairs) p = { 1 + 2 * (int)rng.below(cellsWide(maze)), 1 + 2 * (int)rng.below(cellsHigh(maze)) };
+
+        for (int a = 0; a < 3; a++) {
+            // a fresh searcher per algorithm so memory shows what each needs
+            GridSearch search;
+            long long expanded = 0;
+            int queries = 0;
+            auto t0 = chrono::steady_clock::now();
+            do {
+                const GridPos& s = pairs[(queries * 2) % pairs.size()];
+                const GridPos& t = pairs[(queries * 2 + 1) % pairs.size()];
+                if (a == 0) search.bfs(maze, s.x, s.y, t.x, t.y);
+                else if (a == 1) search.astar(maze, s.x, s.y, t.x, t.y);
+                else search.jps(maze, s.x, s.y, t.x, t.y);
+                expanded += search.expanded();
+                queries++;
+            } while (secondsSince(t0) < seconds);
+            double secs = secondsSince(t0);
+
+            printf("%8d %6s %8d %14lld %12.1f %10.1f\n", maze.width, names[a], queries, expanded / queries,
+                secs * 1e6 / queries, search.memoryBytes() / 1048576.0);
+        }
+    }
+}
+
+void runHpaBenchmark(const vector<int>& sizes, int gen, int clusterSize, int threads, double seconds) {
+    printf("HPA*, %d-cell clusters, generator %s\n", clusterSize, MAZE_GENERATORS[gen].id);
+    printf("%8s %10s %10s %10s %8s %12s %12s %12s\n", "size", "build ms", "nodes", "edges", "MB", "query us", "expanded", "jps us");
+    for (int size : sizes) {
+        Maze maze;
+        maze.resize(size, size);
+        generateMaze(maze, gen, 1);
+
+        HpaGraph hpa;
+        auto t0 = chrono::steady_clock::now();
+        hpa.build(maze, clusterSize, threads);
+        double buildMs = secondsSince(t0) * 1000.0;
+
+        Rng rng(5);
+        vector<GridPos> pairs(64);
+        for (auto& p : pairs) p = { 1 + 2 * (int)rng.below(cellsWide(maze)), 1 + 2 * (int)rng.below(cellsHigh(maze)) };
+
+        long long expanded = 0;
+        int queries = 0;
+        double queryMs = timePerRun(seconds, [&] {
+            const GridPos& s = pairs[(queries * 2) % pairs.size()];
+            const GridPos& t = pairs[(queries * 2 + 1) % pairs.size()];
+            hpa.query(maze, s.x, s.y, t.x, t.y);
+            expanded += hpa.expanded();
+            queries++;
+        });
+
+        GridSearch search;
+        int jpsQueries = 0;
+        double jpsMs = timePerRun(seconds, [&] {
+            const GridPos& s = pairs[(jpsQueries * 2) % pairs.size()];
+            const GridPos& t = pairs[(jpsQueries * 2 + 1) % pairs.size()];
+            search.jps(maze, s.x, s.y, t.x, t.y);
+            jpsQueries++;
+        });
+
+        printf("%8d %10.1f %10d %10lld %8.1f %12.1f %12lld %12.1f\n", maze.width, buildMs, hpa.nodeCount(), hpa.edgeCount(),
+            hpa.memoryBytes() / 1048576.0, queryMs * 1000.0, expanded / queries, jpsMs * 1000.0);
+    }
+}
+
+void runJunctionGraphBenchmark(const vector<int>& sizes, int gen, double seconds) {
+    printf("Junction graph, generator %s\n", MAZE_GENERATORS[gen].id);
+    printf("%8s %10s %10s %10s %8s %10s %10s %10s %10s %12s\n", "size", "build ms", "nodes", "open", "MB",
+        "query us", "astar us", "jps us", "edit us", "rebuild ms");
+    for (int size : sizes) {
+        Maze maze;
+        maze.resize(size, size);
+        generateMaze(maze, gen, 1);
+
+        long long openCells = 0;
+        for (int y = 0; y < maze.height; y++)
+            for (int x = 0; x < maze.width; x++) openCells += maze.isOpen(x, y);
+
+        JunctionGraph graph;
+        auto t0 = chrono::steady_clock::now();
+        graph.build(maze);
+        double buildMs = secondsSince(t0) * 1000.0;
+
+        Rng rng(5);
+        vector<GridPos> pairs(64);
+        for (auto& p : pairs) p = { 1 + 2 * (int)rng.below(cellsWide(maze)), 1 + 2 * (int)rng.below(cellsHigh(maze)) };
+
+        int queries = 0;
+        double queryMs = timePerRun(seconds, [&] {
+            const GridPos& s = pairs[(queries * 2) % pairs.size()];
+            const GridPos& t = pairs[(queries * 2 + 1) % pairs.size()];
+            graph.distance(maze, s.x, s.y, t.x, t.y);
+            queries++;
+        });
+
+        GridSearch search;
+        int astarQueries = 0;
+        double astarMs = timePerRun(seconds, [&] {
+            const GridPos& s = pairs[(astarQueries * 2) % pairs.size()];
+            const GridPos& t = pairs[(astarQueries * 2 + 1) % pairs.size()];
+            search.astar(maze, s.x, s.y, t.x, t.y);
+            astarQueries++;
+        });
+        int jpsQueries = 0;
+        double jpsMs = timePerRun(seconds, [&] {
+            const GridPos& s = pairs[(jpsQueries * 2) % pairs.size()];
+            const GridPos& t = pairs[(jpsQueries * 2 + 1) % pairs.size()];
+            search.jps(maze, s.x, s.y, t.x, t.y);
+            jpsQueries++;
+        });
+
+        // flip the walls between 4 room pairs in an 8x8 box, patch the graph;
+        // every second run flips the same walls back
+        vector<GridPos> flips;
+        int edits = 0;
+        double editMs = timePerRun(seconds, [&] {
+            if (edits % 2 == 0) {
+                int x0 = 1 + 2 * (int)rng.below(max(cellsWide(maze) - 4, 1));
+                int y0 = 1 + 2 * (int)rng.below(max(cellsHigh(maze) - 4, 1));
+                flips.clear();
+                for (int k = 0; k < 4; k++) {
+                    int x = x0 + 2 * (int)rng.below(3), y = y0 + 2 * (int)rng.below(3);
+                    flips.push_back(rng.below(2) ? GridPos{ x + 1, y } : GridPos{ x, y + 1 });
+                }
+            }
+            int x0 = flips[0].x, y0 = flips[0].y, x1 = x0, y1 = y0;
+            for (const GridPos& f : flips) {
+                maze.setWall(f.x, f.y, !maze.isWall(f.x, f.y));
+                x0 = min(x0, f.x); y0 = min(y0, f.y); x1 = max(x1, f.x); y1 = max(y1, f.y);
+            }
+            graph.updateRegion(maze, x0, y0, x1, y1);
+            edits++;
+        });
+        if (edits % 2) {
+            for (const GridPos& f : flips) maze.setWall(f.x, f.y, !maze.isWall(f.x, f.y));
+        }
+
+        JunctionGraph fresh;
+        double rebuildMs = timePerRun(seconds, [&] { fresh.build(maze); });
+
+        printf("%8d %10.1f %10d %10lld %8.1f %10.1f %10.1f %10.1f %10.1f %12.1f\n", maze.width, buildMs, graph.nodeCount(), openCells,
+            graph.memoryBytes() / 1048576.0, queryMs * 1000.0, astarMs * 1000.0, jpsMs * 1000.0, editMs * 1000.0, rebuildMs * 1000.0);
+    }
+}
+
+void runLandmarkBenchmark(const vector<int>& sizes, int gen, int threads, double seconds) {
+    printf("ALT landmarks, generator %s\n", MAZE_GENERATORS[gen].id);
+    printf("%8s %4s %6s %10s %8s %10s %8s %8s %10s %12s %10s %12s\n", "size", "K", "bits", "build ms", "MB",
+        "bound ns", "lower %", "upper %", "alt us", "alt expanded", "astar us", "astar exp.");
+    for (int size : sizes) {
+        Maze maze;
+        maze.resize(size, size);
+        generateMaze(maze, gen, 1);
+
+        Rng rng(5);
+        vector<GridPos> pairs(64);
+        for (auto& p : pairs) p = { 1 + 2 * (int)rng.below(cellsWide(maze)), 1 + 2 * (int)rng.below(cellsHigh(maze)) };
+
+        GridSearch search;
+        vector<int> exact(pairs.size() / 2);
+        long long astarExpanded = 0;
+        for (size_t i = 0; i < exact.size(); i++) {
+            exact[i] = search.astar(maze, pairs[i * 2].x, pairs[i * 2].y, pairs[i * 2 + 1].x, pairs[i * 2 + 1].y);
+            astarExpanded += search.expanded();
+        }
+        int astarQueries = 0;
+        double astarMs = timePerRun(seconds, [&] {
+            const GridPos& s = pairs[(astarQueries * 2) % pairs.size()];
+            const GridPos& t = pairs[(astarQueries * 2 + 1) % pairs.size()];
+            search.astar(maze, s.x, s.y, t.x, t.y);
+            astarQueries++;
+        });
+
+        for (int k : { 4, 8, 16 }) {
+            for (bool compact : { false, true }) {
+                LandmarkOracle oracle;
+                auto t0 = chrono::steady_clock::now();
+                oracle.build(maze, k, compact, threads);
+                double buildMs = secondsSince(t0) * 1000.0;
+
+                // both bounds as a share of the exact distance, averaged
+                double lowerShare = 0, upperShare = 0;
+                for (size_t i = 0; i < exact.size(); i++) {
+                    int lower, upper;
+                    oracle.bounds(pairs[i * 2].x, pairs[i * 2].y, pairs[i * 2 + 1].x, pairs[i * 2 + 1].y, lower, upper);
+                    if (exact[i] <= 0) continue;
+                    lowerShare += (double)lower / exact[i];
+                    upperShare += (double)upper / exact[i];
+                }
+                int boundQueries = 0;
+                long long sink = 0;
+                double boundMs = timePerRun(seconds, [&] {
+                    for (size_t i = 0; i < pairs.size(); i += 2) {
+                        int lower, upper;
+                        oracle.bounds(pairs[i].x, pairs[i].y, pairs[i + 1].x, pairs[i + 1].y, lower, upper);
+                        sink += lower;
+                    }
+                    boundQueries += (int)pairs.size() / 2;
+                });
+
+                long long altExpanded = 0;
+                int altQueries = 0;
+                double altMs = timePerRun(seconds, [&] {
+                    const GridPos& s = pairs[(altQueries * 2) % pairs.size()];
+                    const GridPos& t = pairs[(altQueries * 2 + 1) % pairs.size()];
+                    oracle.distance(maze, s.x, s.y, t.x, t.y);
+                    altExpanded += oracle.expanded();
+                    altQueries++;
+                });
+
+                printf("%8d %4d %6d %10.1f %8.1f %10.1f %8.1f %8.1f %10.1f %12lld %10.1f %12lld%s\n", maze.width, k, compact ? 16 : 32, buildMs,
+                    oracle.memoryBytes() / 1048576.0, boundMs * 1e6 / (pairs.size() / 2), 100.0 * lowerShare / exact.size(), 100.0 * upperShare / exact.size(),
+                    altMs * 1000.0, altExpanded / altQueries, astarMs * 1000.0, astarExpanded / (long long)exact.size(),
+                    sink < 0 ? "!" : "");
+            }
+        }
+    }
+}
+
+void runSwarmBenchmark(int size, const vector<int>& counts, int gen, double seconds) {
+    Maze maze;
+    maze.resize(size, size);
+    generateMaze(maze, gen, 1);
+    DistanceField toGoal;
+    toGoal.buildToGoal(maze);
+    printf("Swarm, %dx%d %s, two hard bots as players\n", maze.width, maze.height, MAZE_GENERATORS[gen].id);
+    // a caught player restarts from here, so that field is kept ready
+    FlowField startField;
+    startField.reset(maze, maze.startX, maze.startY);
+    printf("%10s %14s %14s %14s %10s\n", "enemies", "ticks/s", "rebuild t/s", "cells/update", "catches");
+
+    for (int count : counts) {
+        double ticksPerSec[2] = { 0, 0 };
+        long long touched = 0, updates = 0, catches = 0;
+        for (int mode = 0; mode < 2; mode++) {
+            bool rebuild = (mode == 1);
+            int px[2] = { maze.startX, maze.startX }, py[2] = { maze.startY, maze.startY };
+            MazeBot bots[2];
+            FlowField fields[2];
+            int grace[2] = { 0, 0 };
+            for (int p = 0; p < 2; p++) { bots[p].reset(BOT_HARD, 7 + p); fields[p] = startField; }
+            Swarm swarm;
+            swarm.spawn(maze, fields[0], count, 20, 3);
+
+            long long ticks = 0;
+            auto t0 = chrono::steady_clock::now();
+            while (secondsSince(t0) < seconds || ticks == 0) {
+                for (int i = 0; i < 64; i++, ticks++) {
+                    for (int p = 0; p < 2; p++) {
+                        static const int dx[4] = { 0, 0, -1, 1 };
+                        static const int dy[4] = { -1, 1, 0, 0 };
+                        int d = bots[p].tick(maze, toGoal, px[p], py[p]);
+                        if (d >= 0) { px[p] += dx[d]; py[p] += dy[d]; }
+                        if (px[p] == maze.goalX && py[p] == maze.goalY) { px[p] = maze.startX; py[p] = maze.startY; fields[p] = startField; continue; }
+                        if (rebuild && d >= 0) fields[p].reset(maze, px[p], py[p]);
+                        else fields[p].moveTarget(maze, px[p], py[p]);
+                        if (!rebuild && d >= 0) { touched += fields[p].lastTouched(); updates++; }
+                    }
+                    // a caught player is left alone for two seconds
+                    unsigned hunted = (grace[0] > 0 ? 0u : 1u) | (grace[1] > 0 ? 0u : 2u);
+                    unsigned caught = swarm.tick(fields, 2, hunted);
+                    for (int p = 0; p < 2; p++) {
+                        if (grace[p] > 0) grace[p]--;
+                        if (!(caught & (1u << p))) continue;
+                        if (!rebuild) catches++;
+                        px[p] = maze.startX; py[p] = maze.startY;
+                        fields[p] = startField;
+                        grace[p] = 120;
+                    }
+                }
+            }
+            ticksPerSec[mode] = ticks / secondsSince(t0);
+        }
+        printf("%10d %14.0f %14.0f %14.1f %10lld\n", count, ticksPerSec[0], ticksPerSec[1],
+            updates ? (double)touched / updates : 0.0, catches);
+    }
+}
+
+void runRepairBenchmark(const vector<int>& sizes, int gen, double seconds) {
+    printf("Goal field repair, generator %s\n", MAZE_GENERATORS[gen].id);
+    printf("%8s %8s %8s %12s %14s %12s\n", "size", "board", "edits", "repair us", "cells/repair", "rebuild us");
+    for (int size : sizes) {
+        for (bool loopy : { false, true }) {
+            Maze maze;
+            maze.resize(size, size);
+            generateMaze(maze, gen, 1);
+            Rng rng(9);
+            // wall cells between two rooms, never the border
+            auto randomWall = [&]() {
+                int x = 1 + (int)rng.below(maze.width - 2), y = 1 + (int)rng.below(maze.height - 2);
+                if ((x + y) % 2 == 0) x = (x + 1 < maze.width - 1) ? x + 1 : x - 1;
+                return y * maze.width + x;
+            };
+            // loopy: one wall in ten between rooms knocked out
+            if (loopy)
+                for (long long i = 0; i < (long long)cellsWide(maze) * cellsHigh(maze) / 5; i++) {
+                    int c = randomWall();
+                    maze.setWall(c % maze.width, c / maze.width, false);
+                }
+
+            DistanceField field;
+            field.buildToGoal(maze);
+            DistanceField fresh;
+            double rebuildMs = timePerRun(seconds, [&] { fresh.buildToGoal(maze); });
+
+            FieldRepair repair;
+            for (int edits : { 1, 4, 16, 64, 256, 1024 }) {
+                vector<int> changed(edits);
+                long long touched = 0, repairs = 0;
+                auto flip = [&](int c) { maze.setWall(c % maze.width, c / maze.width, !maze.isWall(c % maze.width, c / maze.width)); };
+                // flip a batch, repair, flip it back, repair
+                double ms = timePerRun(seconds, [&] {
+                    for (int& c : changed) { c = randomWall(); flip(c); }
+                    touched += repair.apply(maze, field, changed);
+                    for (int c : changed) flip(c);
+                    touched += repair.apply(maze, field, changed);
+                    repairs += 2;
+                });
+                printf("%8d %8s %8d %12.1f %14.0f %12.1f\n", maze.width, loopy ? "loopy" : "perfect", edits,
+                    ms * 1000.0 / 2, (double)touched / repairs, rebuildMs * 1000.0);
+            }
+        }
+    }
+}
+
+void runShiftBenchmark(const vector<int>& sizes, int gen, double seconds) {
+    printf("Shifting walls, generator %s, two hard bots with flow fields on them\n", MAZE_GENERATORS[gen].id);
+    printf("%8s %10s %8s %10s %10s %12s %10s\n", "size", "ticks", "shifts", "put back", "mean us", "worst ms", "connected");
+    for (int size : sizes) {
+        Maze maze;
+        maze.resize(size, size);
+        generateMaze(maze, gen, 1);
+        DistanceField toGoal;
+        toGoal.buildToGoal(maze);
+        int px[2] = { maze.startX, maze.startX }, py[2] = { maze.startY, maze.startY };
+        MazeBot bots[2];
+        FlowField fields[3];
+        for (int p = 0; p < 2; p++) { bots[p].reset(BOT_HARD, 7 + p); fields[p].reset(maze, px[p], py[p]); }
+        fields[2].reset(maze, maze.startX, maze.startY);
+        FlowField* flows[3] = { &fields[0], &fields[1], &fields[2] };
+        WallShifter shifter;
+        shifter.reset(maze, 3);
+
+        // only the shifter's own tick is timed, one game tick at a time
+        long long ticks = 0;
+        double total = 0, worst = 0;
+        auto t0 = chrono::steady_clock::now();
+        while (secondsSince(t0) < seconds || ticks == 0) {
+            for (int p = 0; p < 2; p++) {
+                static const int dx[4] = { 0, 0, -1, 1 };
+                static const int dy[4] = { -1, 1, 0, 0 };
+                int d = bots[p].tick(maze, toGoal, px[p], py[p]);
+                if (d >= 0 && maze.isOpen(px[p] + dx[d], py[p] + dy[d])) { px[p] += dx[d]; py[p] += dy[d]; }
+                if (px[p] == maze.goalX && py[p] == maze.goalY) { px[p] = maze.startX; py[p] = maze.startY; fields[p] = fields[2]; }
+                fields[p].moveTarget(maze, px[p], py[p]);
+            }
+            auto t1 = chrono::steady_clock::now();
+            shifter.tick(maze, toGoal, flows, 3, px, py, 2);
+            double t = secondsSince(t1);
+            total += t;
+            worst = max(worst, t);
+            ticks++;
+        }
+
+        vector<int> dist;
+        bool connected = bfsDistances(maze, maze.goalX, maze.goalY, dist) == maze.countOpen();
+        printf("%8d %10lld %8d %10d %10.1f %12.2f %10s\n", maze.width, ticks, shifter.shifts(), shifter.putBack(),
+            total * 1e6 / ticks, worst * 1000.0, connected ? "yes" : "NO");
+    }
+}
+
+// Mismatches of a flow field against a fresh BFS from its player: the same
+// cells reachable, never shorter than the real distance, and a way down
+// from every reachable cell but the player's
+static long long flowMismatches(const Maze& maze, const FlowField& flow, const DistanceField& truth) {
+    long long bad = 0;
+    int target = flow.targetY() * maze.width + flow.targetX();
+    for (int y = 0; y < maze.height; y++)
+        for (int x = 0; x < maze.width; x++) {
+            int c = y * maze.width + x, d = flow.distanceAt(c), real = truth.at(x, y);
+            if ((d >= 0) != (real >= 0) || d < real) bad++;
+            else if (d >= 0 && c != target && flow.nextCell(c) < 0) bad++;
+        }
+    return bad;
+}
+
+static long long repairMismatches(const DistanceField& field, const DistanceField& truth) {
+    long long bad = 0;
+    for (size_t i = 0; i < truth.dist.size(); i++) bad += field.dist[i] != truth.dist[i];
+    return bad;
+}
+
+bool runRepairChecks(int gen) {
+    bool ok = true;
+    auto report = [&](const char* name, long long bad) {
+        printf("%-46s %s", name, bad ? "FAILED" : "ok");
+        if (bad) printf(" (%lld cells)", bad);
+        printf("\n");
+        if (bad) ok = false;
+    };
+
+    // a 5x5 pocket near the goal walled off before the fields are built,
+    // then one wall of it opened
+    {
+        Maze maze;
+        maze.resize(63, 63);
+        generateMaze(maze, gen, 5);
+        int x0 = maze.width - 8, y0 = maze.height - 8; // pocket rooms start at odd x0, y0
+        for (int y = y0 - 1; y <= y0 + 5; y++)
+            for (int x = x0 - 1; x <= x0 + 5; x++)
+                maze.setWall(x, y, x < x0 || y < y0 || x > x0 + 4 || y > y0 + 4);
+        FlowField flow;
+        flow.reset(maze, maze.startX, maze.startY);
+        DistanceField field, truth;
+        field.build(maze, maze.startX, maze.startY);
+        FieldRepair repair;
+
+        // the room left of the pocket is open, so is the pocket's corner
+        vector<int> changed = { (y0 + 2) * maze.width + x0 - 1 };
+        maze.setWall(x0 - 1, y0 + 2, false);
+        flow.wallsChanged(maze, changed);
+        repair.apply(maze, field, changed);
+        truth.build(maze, maze.startX, maze.startY);
+        report("flow field, opening into a walled-off pocket", flowMismatches(maze, flow, truth));
+        report("goal field, opening into a walled-off pocket", repairMismatches(field, truth));
+    }
+
+    // random single wall flips between rooms, walls going up and coming
+    // down, each repair checked against a fresh BFS
+    for (bool opensOnly : { false, true }) {
+        Maze maze;
+        maze.resize(63, 63);
+        generateMaze(maze, gen, 6);
+        Rng rng(11);
+        auto randomWall = [&]() {
+            int x = 1 + (int)rng.below(maze.width - 2), y = 1 + (int)rng.below(maze.height - 2);
+            if ((x + y) % 2 == 0) x = (x + 1 < maze.width - 1) ? x + 1 : x - 1;
+            return y * maze.width + x;
+        };
+        // cut some pockets first when only openings are tested
+        if (opensOnly)
+            for (int i = 0; i < 400; i++) { int c = randomWall(); maze.setWall(c % maze.width, c / maze.width, true); }
+        FlowField flow;
+        flow.reset(maze, maze.startX, maze.startY);
+        DistanceField field, truth;
+        field.build(maze, maze.startX, maze.startY);
+        FieldRepair repair;
+        long long flowBad = 0, fieldBad = 0;
+        vector<int> changed(1);
+        for (int i = 0; i < 2000; i++) {
+            int c = randomWall(), x = c % maze.width, y = c / maze.width;
+            if (opensOnly && !maze.isWall(x, y)) continue;
+            maze.setWall(x, y, !maze.isWall(x, y));
+            changed[0] = c;
+            flow.wallsChanged(maze, changed);
+            repair.apply(maze, field, changed);
+            truth.build(maze, maze.startX, maze.startY);
+            flowBad += flowMismatches(maze, flow, truth);
+            fieldBad += repairMismatches(field, truth);
+        }
+        report(opensOnly ? "flow field, random openings on a cut-up board" : "flow field, random wall flips", flowBad);
+        report(opensOnly ? "goal field, random openings on a cut-up board" : "goal field, random wall flips", fieldBad);
+    }
+
+    // a long random walk, so the trail refresh runs several times, with a
+    // wall flipped now and then to cancel one halfway
+    {
+        Maze maze;
+        maze.resize(63, 63);
+        generateMaze(maze, gen, 8);
+        Rng rng(12);
+        static const int dx[4] = { 0, 0, -1, 1 };
+        static const int dy[4] = { -1, 1, 0, 0 };
+        int x = maze.startX, y = maze.startY;
+        FlowField flow;
+        flow.reset(maze, x, y);
+        DistanceField truth;
+        long long bad = 0;
+        vector<int> changed(1);
+        for (int i = 1; i <= 4000; i++) {
+            int d = (int)rng.below(4);
+            if (maze.isOpen(x + dx[d], y + dy[d])) { x += dx[d]; y += dy[d]; }
+            flow.moveTarget(maze, x, y);
+            if (i % 700 == 0) {
+                // a wall between two rooms, away from the player's cell
+                int wx = 1 + 2 * (int)rng.below(cellsWide(maze) - 1) + 1, wy = 1 + 2 * (int)rng.below(cellsHigh(maze));
+                if (wx == x && wy == y) continue;
+                maze.setWall(wx, wy, !maze.isWall(wx, wy));
+                changed[0] = wy * maze.width + wx;
+                flow.wallsChanged(maze, changed);
+            }
+            if (i % 10 == 0) {
+                truth.build(maze, x, y);
+                bad += flowMismatches(maze, flow, truth);
+            }
+        }
+        report("flow field, long walk with trail refreshes", bad);
+    }
+
+    // the shifter's own repairs: goal field and three flow fields checked
+    // after every shift that sticks
+    {
+        Maze maze;
+        maze.resize(63, 63);
+        generateMaze(maze, gen, 7);
+        DistanceField toGoal, truth;
+        toGoal.buildToGoal(maze);
+        int px[2] = { maze.startX, maze.goalX }, py[2] = { maze.startY, maze.goalY };
+        FlowField fields[3];
+        for (int p = 0; p < 2; p++) fields[p].reset(maze, px[p], py[p]);
+        fields[2].reset(maze, maze.startX, maze.startY);
+        FlowField* flows[3] = { &fields[0], &fields[1], &fields[2] };
+        WallShifter shifter;
+        shifter.reset(maze, 3);
+        long long flowBad = 0, fieldBad = 0;
+        for (int tick = 0; tick < 200 * SHIFT_INTERVAL_TICKS; tick++) {
+            if (!shifter.tick(maze, toGoal, flows, 3, px, py, 2)) continue;
+            truth.buildToGoal(maze);
+            fieldBad += repairMismatches(toGoal, truth);
+            for (FlowField& f : fields) {
+                truth.build(maze, f.targetX(), f.targetY());
+                flowBad += flowMismatches(maze, f, truth);
+            }
+        }
+        report("flow fields, shifting walls", flowBad);
+        report("goal field, shifting walls", fieldBad);
+    }
+    return ok;
+}
+
+// counts rows, keeps nothing
+class CountRowSink : public MazeRowSink {
+public:
+    long long rows = 0;
+    void writeRow(const uint64_t*, int) override { rows++; }
+};
+
+bool runStreamChecks() {
+    bool ok = true;
+    auto report = [&](const char* name, long long bad) {
+        printf("%-46s %s", name, bad ? "FAILED" : "ok");
+        if (bad) printf(" (%lld cells)", bad);
+        printf("\n");
+        if (bad) ok = false;
+    };
+
+    // the generator thread has to wait for the reader every few rows
+    {
+        const int w = 255, h = 511;
+        Maze direct, viaRing;
+        direct.resize(w, h);
+        viaRing.resize(w, h);
+        viaRing.fillAllWithWalls();
+        MazeFillSink directSink(direct), ringSink(viaRing);
+        generateEllerStream(w, h, directSink, 11);
+
+        RowRingBuffer ring(w, 3);
+        thread producer([&] { generateEllerStream(w, h, ring, 11); });
+        vector<uint64_t> row(viaRing.rowWords);
+        long long bad = 0;
+        for (long long y = 0; y < h && ring.waitForRow(y); y++) {
+            for (int x = 0; x < w; x++) bad += ring.isWall(x, y) != direct.isWall(x, (int)y);
+            ring.readRow(y, row.data());
+            ring.releaseBefore(y + 1);
+            ringSink.writeRow(row.data(), w);
+        }
+        ring.close();
+        producer.join();
+        for (int y = 0; y < h; y++)
+            for (int x = 0; x < w; x++) bad += viaRing.isWall(x, y) != direct.isWall(x, y);
+        report("eller stream through a 3-row ring", bad);
+    }
+
+    {
+        CountRowSink count;
+        generateEllerStream(31, 40, count, 12);
+        report("even stream height gives height + 1 rows", llabs(count.rows - 41));
+    }
+    return ok;
+}
+
+bool runEllerStreamToFile(int width, long long height, const string& path, uint64_t seed, int ringRows) {
+    ofstream file;
+    if (path != "-") {
+        file.open(path, ios::trunc | ios::binary);
+        if (!file) { fprintf(stderr, "cannot open %s\n", path.c_str()); return false; }
+    }
+    ostream& out = (path == "-") ? cout : file;
+    TextRowSink sink(out);
+    width = clampMazeSize(width);
+    long long rows = clampStreamHeight(height);
+    if (rows != height) fprintf(stderr, "eller stream: height %lld rounded to %lld\n", height, rows);
+
+    auto t0 = chrono::steady_clock::now();
+    if (ringRows <= 0) generateEllerStream(width, rows, sink, seed);
+    else {
+        // the generator runs ahead on its own thread, at most ringRows rows
+        RowRingBuffer ring(width, ringRows);
+        thread producer([&] { generateEllerStream(width, rows, ring, seed); });
+        vector<uint64_t> row((width + 63) / 64);
+        for (long long y = 0; y < rows && ring.waitForRow(y); y++) {
+            ring.readRow(y, row.data());
+            ring.releaseBefore(y + 1);
+            sink.writeRow(row.data(), width);
+        }
+        ring.close();
+        producer.join();
+    }
+    out.flush();
+    double secs = secondsSince(t0);
+
+    fprintf(stderr, "eller stream: %d x %lld grid rows, seed %llu, in %.2f s (%.0f rows/s)\n",
+        width, rows, (unsigned long long)seed, secs, rows / secs);
+    return (bool)out;
+}
@@ -0,0 +1,74 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Headless benchmarks, printed to stdout
+
+// Single-thread time per maze for every generator at a few sizes
+void runGeneratorBenchmark();
+
+// Whole mazes per second with `threads` workers (0 = one per core), each
+// worker generating into its own Maze with its own seeds
+double runThroughputBenchmark(int gen, int size, int threads, double seconds);
+
+// Tiled generator at one big size, 1, 2, 4 ... threads up to the core count
+void runParallelScalingBenchmark(int size);
+
+// Goal distance field build time and memory per board size
+void runDistanceFieldBenchmark(const std::vector<int>& sizes, int gen, double seconds);
+
+// Scalar BFS against the bit-parallel one (reachability only, and with the
+// full distance array) from the goal of one maze per size
+void runBitBfsBenchmark(const std::vector<int>& sizes, int gen, double seconds);
+
+// 64 sources x 16 targets: one multi-source pass against 64 single BFS runs
+void runMultiBfsBenchmark(const std::vector<int>& sizes, int gen, double seconds);
+
+// Point-to-point queries between random cells: BFS vs A* vs JPS, with
+// nodes expanded, time per query and search buffer memory
+void runSearchBenchmark(const std::vector<int>& sizes, int gen, double seconds);
+
+// HPA* build cost and graph size, then random point queries against JPS
+void runHpaBenchmark(const std::vector<int>& sizes, int gen, int clusterSize, int threads, double seconds);
+
+// Junction graph: build time, nodes against open cells, point queries
+// against cell-level A* / JPS, and a small local wall edit patched in place
+// against a full rebuild
+void runJunctionGraphBenchmark(const std::vector<int>& sizes, int gen, double seconds);
+
+// ALT landmark oracle for 4, 8 and 16 landmarks, 32- and 16-bit values:
+// build time, memory, O(K) bound queries and how tight they are, and A*
+// with landmark bounds against A* with the Manhattan distance
+void runLandmarkBenchmark(const std::vector<int>& sizes, int gen, int threads, double seconds);
+
+// Chaser swarm: two bot players race to the goal while counts[i] enemies
+// hunt them on a size x size board. Ticks per second with the incremental
+// flow fields against rebuilding both fields on every player step.
+void runSwarmBenchmark(int size, const std::vector<int>& counts, int gen, double seconds);
+
+// Goal field repair after a batch of random wall flips (then flipped back)
+// against rebuilding the field, per batch size
+void runRepairBenchmark(const std::vector<int>& sizes, int gen, double seconds);
+
+// Shifting walls with two bot players walking the board: shifts and
+// put-back tries, mean and worst time per game tick, and whether the board
+// is still in one piece at the end
+void runShiftBenchmark(const std::vector<int>& sizes, int gen, double seconds);
+
+// Checks, not timings: the goal field repair and the flow fields against a
+// fresh BFS after wall edits, including openings into pockets that were cut
+// off, and after the shifter's own edits. Prints each case; false on any
+// mismatch.
+bool runRepairChecks(int gen);
+
+// Checks for the streaming generator: an Eller stream read back through a
+// small RowRingBuffer on another thread against the same stream poured
+// straight into a Maze, and the row count of an even height.
+bool runStreamChecks();
+
+// Streams a width x height Eller maze to a text file ("-" = stdout) and
+// reports rows/s on stderr. Height may be far bigger than MAX_MAZE_SIZE.
+// ringRows > 0 generates on a second thread through a RowRingBuffer of
+// that many rows, the way a scrolling reader would consume it.
+bool runEllerStreamToFile(int width, long long height, const std::string& path, uint64_t seed, int ringRows = 0);
@@ -0,0 +1,281 @@
+#include "MazeBitBfs.h"
+#include <algorithm>
+#include <bit>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+using namespace std;
+
+// -------------------- LOADING --------------------
+// Working index of grid cell (x, y) is (y + 1) * stride + (x >> 6) + 1
+void BitBfs::load(const Maze& maze) {
+    width = maze.width;
+    stride = maze.rowWords + 2;
+    rows = maze.height + 2;
+    size_t total = (size_t)stride * rows;
+
+    open.assign(total, 0);
+    visited.assign(total, 0);
+    cur.assign(total, 0);
+    next.assign(total, 0);
+    // a word is listed at most once per layer, plus slack for the branch-free append
+    if (curList.size() < total + 5) { curList.resize(total + 5); nextList.resize(total + 5); }
+
+    uint64_t lastMask = maze.lastWordMask();
+    for (int y = 0; y < maze.height; y++) {
+        const uint64_t* src = maze.row(y);
+        uint64_t* dst = &open[(size_t)(y + 1) * stride + 1];
+        for (int k = 0; k < maze.rowWords; k++) dst[k] = ~src[k];
+        dst[maze.rowWords - 1] &= lastMask;
+    }
+}
+
+void BitBfs::writeLayer(const int* words, size_t count, vector<int>& out, int d) const {
+    for (size_t n = 0; n < count; n++) {
+        int i = words[n];
+        int y = i / stride - 1;
+        int x0 = (i % stride - 1) * 64;
+        int* row = &out[(size_t)y * width + x0];
+        for (uint64_t m = next[i]; m; m &= m - 1) row[std::countr_zero(m)] = d;
+    }
+}
+
+bool BitBfs::isReached(int x, int y) const {
+    if ((unsigned)x >= (unsigned)width || (unsigned)y >= (unsigned)(rows - 2)) return false;
+    return (visited[(size_t)(y + 1) * stride + (x >> 6) + 1] >> (x & 63)) & 1;
+}
+
+// -------------------- DENSE SWEEP --------------------
+// One layer over every word: next = spread(cur) & open & ~visited.
+// Returns the number of non-zero words in next.
+static size_t denseStep(const uint64_t* cur, uint64_t* next, const uint64_t* open, uint64_t* visited,
+    size_t from, size_t to, size_t stride) {
+    size_t nonZero = 0;
+    size_t i = from;
+#if defined(__AVX2__)
+    for (; i + 4 <= to; i += 4) {
+        __m256i c = _mm256_loadu_si256((const __m256i*)(cur + i));
+        __m256i left = _mm256_loadu_si256((const __m256i*)(cur + i - 1));
+        __m256i right = _mm256_loadu_si256((const __m256i*)(cur + i + 1));
+        __m256i up = _mm256_loadu_si256((const __m256i*)(cur + i - stride));
+        __m256i down = _mm256_loadu_si256((const __m256i*)(cur + i + stride));
+
+        __m256i spread = _mm256_or_si256(_mm256_or_si256(c, _mm256_slli_epi64(c, 1)), _mm256_srli_epi64(c, 1));
+        spread = _mm256_or_si256(spread, _mm256_srli_epi64(left, 63));
+        spread = _mm256_or_si256(spread, _mm256_slli_epi64(right, 63));
+        spread = _mm256_or_si256(spread, _mm256_or_si256(up, down));
+
+        __m256i v = _mm256_loadu_si256((const __m256i*)(visited + i));
+        __m256i n = _mm256_andnot_si256(v, _mm256_and_si256(spread, _mm256_loadu_si256((const __m256i*)(open + i))));
+        _mm256_storeu_si256((__m256i*)(next + i), n);
+        _mm256_storeu_si256((__m256i*)(visited + i), _mm256_or_si256(v, n));
+
+        if (!_mm256_testz_si256(n, n))
+            for (int k = 0; k < 4; k++) nonZero += (next[i + k] != 0);
+    }
+#endif
+    for (; i < to; i++) {
+        uint64_t c = cur[i];
+        uint64_t spread = c | (c << 1) | (c >> 1) | (cur[i - 1] >> 63) | (cur[i + 1] << 63) | cur[i - stride] | cur[i + stride];
+        uint64_t n = spread & open[i] & ~visited[i];
+        next[i] = n;
+        visited[i] |= n;
+        nonZero += (n != 0);
+    }
+    return nonZero;
+}
+
+// -------------------- BFS --------------------
+long long BitBfs::run(const Maze& maze, int sx, int sy, vector<int>* dist, int tx, int ty) {
+    load(maze);
+    sizes.clear();
+    layerCount = 0;
+    denseCount = 0;
+    if (dist) dist->assign((size_t)maze.width * maze.height, -1);
+    if (!maze.isOpen(sx, sy)) return 0;
+
+    int start = (sy + 1) * stride + (sx >> 6) + 1;
+    cur[start] = visited[start] = 1ull << (sx & 63);
+    curList[0] = start;
+    size_t curCount = 1, nextCount = 0;
+    if (dist) (*dist)[(size_t)sy * width + sx] = 0;
+    sizes.push_back(1);
+    layerCount = 1;
+    long long reached = 1;
+
+    bool hasTarget = maze.inGrid(tx, ty);
+    int targetWord = hasTarget ? (ty + 1) * stride + (tx >> 6) + 1 : 0;
+    uint64_t targetBit = hasTarget ? 1ull << (tx & 63) : 0;
+    if (hasTarget && start == targetWord && (cur[start] & targetBit)) return reached;
+
+    // sweep every word once the frontier spans this many
+    size_t total = (size_t)stride * rows;
+    size_t denseAt = total / 16 + 1;
+    bool dense = false;
+
+    for (int d = 1;; d++) {
+        long long count = 0;
+        if (!dense) {
+            // branch-free: every target word is written and appended to the
+            // list, but the list only grows when the word turned non-zero
+            nextCount = 0;
+            for (size_t n = 0; n < curCount; n++) {
+                int i = curList[n];
+                uint64_t f = cur[i];
+                cur[i] = 0;
+                const int targets[5] = { i, i - 1, i + 1, i - stride, i + stride };
+                const uint64_t spread[5] = { (f << 1) | (f >> 1), f << 63, f >> 63, f, f };
+                for (int k = 0; k < 5; k++) {
+                    int j = targets[k];
+                    uint64_t v = visited[j];
+                    uint64_t m = spread[k] & open[j] & ~v;
+                    uint64_t was = next[j];
+                    next[j] = was | m;
+                    visited[j] = v | m;
+                    nextList[nextCount] = j;
+                    nextCount += (was == 0) & (m != 0);
+                }
+            }
+            if (!nextCount) break;
+            for (size_t n = 0; n < nextCount; n++) count += std::popcount(next[nextList[n]]);
+            if (dist) writeLayer(nextList.data(), nextCount, *dist, d);
+            if (nextCount >= denseAt) dense = true;
+        }
+        else {
+            // guard rows stay zero, so the sweep covers the real rows only
+            size_t nonZero = denseStep(cur.data(), next.data(), open.data(), visited.data(), stride, total - stride, stride);
+            denseCount++;
+            if (!nonZero) break;
+
+            nextCount = 0;
+            for (size_t i = stride; i < total - stride; i++)
+                if (next[i]) { nextList[nextCount++] = (int)i; count += std::popcount(next[i]); }
+            if (dist) writeLayer(nextList.data(), nextCount, *dist, d);
+
+            if (nonZero < denseAt / 4) {
+                // back to sparse: the stale words of the old frontier must go
+                dense = false;
+                for (size_t i = 0; i < total; i++) cur[i] = 0;
+            }
+        }
+
+        swap(cur, next);
+        swap(curList, nextList);
+        curCount = nextCount;
+        sizes.push_back(count);
+        layerCount++;
+        reached += count;
+        if (hasTarget && (visited[targetWord] & targetBit)) break;
+    }
+    return reached;
+}
+
+// -------------------- QUERIES --------------------
+int bitDistance(const Maze& maze, int sx, int sy, int tx, int ty) {
+    BitBfs bfs;
+    bfs.run(maze, sx, sy, nullptr, tx, ty);
+    return bfs.isReached(tx, ty) ? bfs.layers() - 1 : -1;
+}
+
+bool bitConnected(const Maze& maze) {
+    BitBfs bfs;
+    return bfs.run(maze, maze.startX, maze.startY) == maze.countOpen();
+}
+
+// -------------------- MULTI-SOURCE BFS --------------------
+// Cells are addressed by their bit in Maze::bits (y * rowWords * 64 + x), so
+// the wall test is a single bit read. Widths are always odd, so every row has
+// padding wall bits after its last cell and x +/- 1 never wraps to a real cell.
+struct LaneEntry {
+    uint32_t cell;
+    uint64_t lanes;
+};
+
+static void multiSourceBatch(const Maze& maze, const GridPos* sources, int count,
+    const vector<GridPos>& targets, vector<int>& dist, int firstSource) {
+    const uint64_t* wall = maze.bits.data();
+    uint64_t rowBits = (uint64_t)maze.rowWords * 64;
+    uint64_t totalBits = rowBits * maze.height;
+    size_t targetCount = targets.size();
+
+    vector<uint64_t> seen(totalBits, 0);
+    vector<LaneEntry> cur, next;
+
+    // targets are few: one bit each to test, a scan to find which
+    vector<uint64_t> isTarget(maze.bits.size(), 0);
+    vector<uint32_t> targetCell(targetCount);
+    for (size_t t = 0; t < targetCount; t++) {
+        targetCell[t] = (uint32_t)(targets[t].y * rowBits + targets[t].x);
+        if (maze.isOpen(targets[t].x, targets[t].y)) isTarget[targetCell[t] >> 6] |= 1ull << (targetCell[t] & 63);
+    }
+
+    long long pending = 0;
+    auto arrive = [&](uint32_t cell, uint64_t lanes, int d) {
+        if (!((isTarget[cell >> 6] >> (cell & 63)) & 1)) return;
+        for (size_t t = 0; t < targetCount; t++) {
+            if (targetCell[t] != cell) continue;
+            for (uint64_t m = lanes; m; m &= m - 1) {
+                int s = firstSource + std::countr_zero(m);
+                dist[(size_t)s * targetCount + t] = d;
+                pending--;
+            }
+        }
+    };
+
+    for (int i = 0; i < count; i++) {
+        if (!maze.isOpen(sources[i].x, sources[i].y)) continue;
+        uint32_t cell = (uint32_t)(sources[i].y * rowBits + sources[i].x);
+        uint64_t lane = 1ull << i;
+        if (seen[cell] == 0) cur.push_back({ cell, 0 });
+        for (size_t n = 0; n < cur.size(); n++) if (cur[n].cell == cell) cur[n].lanes |= lane;
+        seen[cell] |= lane;
+        for (size_t t = 0; t < targetCount; t++) if (maze.isOpen(targets[t].x, targets[t].y)) pending++;
+    }
+    for (size_t n = 0; n < cur.size(); n++) arrive(cur[n].cell, cur[n].lanes, 0);
+
+    const int64_t offsets[4] = { -(int64_t)rowBits, (int64_t)rowBits, -1, 1 };
+    for (int d = 1; !cur.empty() && pending > 0; d++) {
+        next.clear();
+        for (size_t n = 0; n < cur.size(); n++) {
+            uint32_t c = cur[n].cell;
+            uint64_t lanes = cur[n].lanes;
+            for (int k = 0; k < 4; k++) {
+                uint64_t nb = (uint64_t)((int64_t)c + offsets[k]);
+                if (nb >= totalBits || ((wall[nb >> 6] >> (nb & 63)) & 1)) continue;
+                uint64_t m = lanes & ~seen[nb];
+                if (!m) continue;
+                // a cell reached by several entries in one layer is listed
+                // once per entry; each carries only its new lanes
+                seen[nb] |= m;
+                next.push_back({ (uint32_t)nb, m });
+                arrive((uint32_t)nb, m, d);
+            }
+        }
+        swap(cur, next);
+    }
+}
+
+void multiSourceDistances(const Maze& maze, const vector<GridPos>& sources,
+    const vector<GridPos>& targets, vector<int>& dist) {
+    // steps are symmetric: when there are fewer targets, run from them
+    // instead (fewer lanes and batches) and transpose
+    if (targets.size() < sources.size()) {
+        vector<int> flipped(sources.size() * targets.size(), -1);
+        for (size_t first = 0; first < targets.size(); first += MULTI_BFS_LANES) {
+            int count = (int)min(targets.size() - first, (size_t)MULTI_BFS_LANES);
+            multiSourceBatch(maze, &targets[first], count, sources, flipped, (int)first);
+        }
+        dist.assign(sources.size() * targets.size(), -1);
+        for (size_t t = 0; t < targets.size(); t++)
+            for (size_t s = 0; s < sources.size(); s++)
+                dist[s * targets.size() + t] = flipped[t * sources.size() + s];
+        return;
+    }
+
+    dist.assign(sources.size() * targets.size(), -1);
+    for (size_t first = 0; first < sources.size(); first += MULTI_BFS_LANES) {
+        int count = (int)min(sources.size() - first, (size_t)MULTI_BFS_LANES);
+        multiSourceBatch(maze, &sources[first], count, targets, dist, (int)first);
+    }
+}
@@ -0,0 +1,66 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "Maze.h"
+
+// -------------------- BIT-PARALLEL BFS --------------------
+// BFS on the packed rows, 64 cells per operation. A frontier word spreads to
+// its neighbours with shifts (left/right, carrying across words) and plain
+// copies (rows above/below), then is ANDed with the open mask and the
+// not-yet-visited mask. Small frontiers only touch their own words; once the
+// frontier covers a good part of the board every word is swept, with AVX2
+// when the compiler targets it (/arch:AVX2, -mavx2) and plain 64-bit words
+// otherwise.
+//
+// Working rows have a guard word at each end and there is a guard row above
+// and below, so no step needs a bounds check. Buffers are kept between runs.
+class BitBfs {
+public:
+    // Layer by layer from (sx, sy). With dist, also writes steps per grid
+    // cell (y * width + x, -1 unreached, same as bfsDistances). Stops early
+    // once (tx, ty) is reached when given. Returns cells reached.
+    long long run(const Maze& maze, int sx, int sy, std::vector<int>* dist = nullptr, int tx = -1, int ty = -1);
+
+    // Results of the last run
+    bool isReached(int x, int y) const;
+    int layers() const { return layerCount; }                   // distance of the farthest cell + 1
+    const std::vector<long long>& layerSizes() const { return sizes; } // cells at each distance
+    int denseLayers() const { return denseCount; }              // layers that swept every word
+
+private:
+    int stride = 0, rows = 0, width = 0;
+    std::vector<uint64_t> open, visited, cur, next;
+    std::vector<int> curList, nextList;   // frontier word indices (sparse layers)
+    std::vector<long long> sizes;
+    int layerCount = 0, denseCount = 0;
+
+    void load(const Maze& maze);
+    void writeLayer(const int* words, size_t count, std::vector<int>& dist, int d) const;
+};
+
+// Steps from (sx, sy) to (tx, ty), -1 if unreachable
+int bitDistance(const Maze& maze, int sx, int sy, int tx, int ty);
+
+// Every open cell reachable from the start
+bool bitConnected(const Maze& maze);
+
+// -------------------- MULTI-SOURCE BFS --------------------
+// Up to 64 BFS in one pass: every cell keeps a 64-bit lane word, bit i set
+// once source i has reached it. A frontier entry carries all the lanes that
+// arrived at a cell on the same layer, so sources sharing corridors share
+// the work. Lanes only meet when they reach a cell on the same layer, which
+// is rare in a maze, so the win comes from running from the smaller side and
+// stopping once every pair is known. A full matrix still costs about one BFS
+// per source (bench --multibfs times both). A dense sweep of the lane words
+// would be worse: a maze has thousands of layers. More sources run in
+// batches of 64. Needs 8 bytes per grid cell.
+const int MULTI_BFS_LANES = 64;
+
+struct GridPos {
+    int x, y;
+};
+
+// dist[s * targets.size() + t] = steps from sources[s] to targets[t],
+// -1 if unreachable. Stops as soon as every pair is known.
+void multiSourceDistances(const Maze& maze, const std::vector<GridPos>& sources,
+    const std::vector<GridPos>& targets, std::vector<int>& dist);
@@ -0,0 +1,100 @@
+#include "MazeBot.h"
+
+using namespace std;
+
+// up, down, left, right; d ^ 1 is the opposite direction
+static const int stepX[4] = { 0, 0, -1, 1 };
+static const int stepY[4] = { -1, 1, 0, 0 };
+static const int rightOf[4] = { 3, 2, 0, 1 };
+static const int leftOf[4] = { 2, 3, 1, 0 };
+
+const BotLevel BOT_LEVELS[BOT_LEVEL_COUNT] = {
+    { "perfect", "Perfect", 6, 0, 0, false },
+    { "hard", "Hard", 8, 4, 5, false },
+    { "medium", "Medium", 10, 12, 15, false },
+    { "easy", "Easy", 12, 20, 10, true },
+};
+
+const char* botLevelName(int level) {
+    if (level < 0 || level >= BOT_LEVEL_COUNT) return "Human";
+    return BOT_LEVELS[level].name;
+}
+
+int findBotLevel(const string& id) {
+    for (int l = 0; l < BOT_LEVEL_COUNT; l++)
+        if (id == BOT_LEVELS[l].id) return l;
+    return -1;
+}
+
+// true when the corridor leaving junction node in direction dir ends in a dead branch
+static bool leadsIntoDeadBranch(const JunctionGraph& graph, int node, int dir) {
+    for (int e = graph.edgeBegin(node); e < graph.edgeEnd(node); e++)
+        if (graph.edgeDir(e) == dir) return graph.isDeadBranch(graph.edgeTo(e));
+    return false;
+}
+
+void MazeBot::reset(int level, uint64_t seed) {
+    botLevel = (level >= 0 && level < BOT_LEVEL_COUNT) ? level : BOT_PERFECT;
+    rng.reseed(seed);
+    wait = BOT_LEVELS[botLevel].moveTicks;
+    facing = -1;
+    lost = false;
+    moveCount = 0;
+    mistakeCount = 0;
+    giveUpAt = 0;
+}
+
+int MazeBot::tick(const Maze& maze, const DistanceField& toGoal, int x, int y, const JunctionGraph* graph) {
+    if (--wait > 0) return -1;
+    const BotLevel& lv = BOT_LEVELS[botLevel];
+    int here = toGoal.at(x, y);
+    if (here <= 0) { wait = 1; return -1; } // at the goal, or no way there
+
+    int open[4], exits = 0;
+    for (int k = 0; k < 4; k++)
+        if (maze.isOpen(x + stepX[k], y + stepY[k])) open[exits++] = k;
+
+    // a wall follower that wandered far too long reads the field instead,
+    // so a loop around the goal cannot keep it out forever
+    if (giveUpAt == 0) giveUpAt = maze.width * maze.height;
+    bool follow = lv.wallFollower && moveCount < giveUpAt;
+
+    int dir = -1;
+    if (follow) {
+        // right hand on the wall: right, straight, left, back
+        int f = facing < 0 ? open[0] : facing;
+        const int order[4] = { rightOf[f], f, leftOf[f], f ^ 1 };
+        // skip dead branches, unless a wrong turn already took it into one
+        int node = graph ? graph->nodeAt(x, y) : -1;
+        bool prune = node >= 0 && !graph->isDeadBranch(node);
+        for (int k : order) {
+            if (!maze.isOpen(x + stepX[k], y + stepY[k])) continue;
+            if (prune && leadsIntoDeadBranch(*graph, node, k)) continue;
+            dir = k;
+            break;
+        }
+        if (dir < 0 && exits > 0) dir = open[0];
+    } else if (lost && exits == 2) {
+        // after a wrong turn: keep going until the next junction or dead end
+        dir = (open[0] == (facing ^ 1)) ? open[1] : open[0];
+    } else {
+        int nx, ny;
+        dir = toGoal.nextStep(x, y, nx, ny);
+        lost = false;
+    }
+
+    // junction: maybe take some other way, and hesitate before the next one
+    if (exits >= 3 && lv.mistakePercent > 0 && (int)rng.below(100) < lv.mistakePercent) {
+        int other = open[rng.below(exits)];
+        if (other != dir && (facing < 0 || other != (facing ^ 1))) { dir = other; lost = true; mistakeCount++; }
+    }
+    if (dir < 0) { wait = 1; return -1; }
+
+    int nx = x + stepX[dir], ny = y + stepY[dir];
+    int nextExits = 0;
+    for (int k = 0; k < 4; k++) nextExits += maze.isOpen(nx + stepX[k], ny + stepY[k]);
+    wait = lv.moveTicks + (nextExits >= 3 ? lv.reactionTicks : 0);
+    facing = dir;
+    moveCount++;
+    return dir;
+}
@@ -0,0 +1,58 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include "Maze.h"
+#include "MazeGraph.h"
+#include "MazeSolve.h"
+#include "Rng.h"
+
+// -------------------- BOT --------------------
+// Computer player for player 2's slot. Every tick costs O(1): the strong
+// levels read the goal distance field the game already keeps, the weak
+// ones follow the right-hand wall. Same seed, same moves.
+
+// Difficulty levels (ids index BOT_LEVELS)
+const int BOT_PERFECT = 0;  // shortest path, never wrong
+const int BOT_HARD = 1;
+const int BOT_MEDIUM = 2;
+const int BOT_EASY = 3;     // wall follower
+const int BOT_LEVEL_COUNT = 4;
+
+struct BotLevel {
+    const char* id;         // short name for the command line
+    const char* name;       // shown in the menu
+    int moveTicks;          // ticks per step (60 ticks per second)
+    int reactionTicks;      // extra wait on reaching a junction
+    int mistakePercent;     // chance of a wrong turn at a junction
+    bool wallFollower;      // right hand on the wall instead of the field
+};
+
+extern const BotLevel BOT_LEVELS[BOT_LEVEL_COUNT];
+
+const char* botLevelName(int level);
+int findBotLevel(const std::string& id); // -1 when unknown
+
+class MazeBot {
+public:
+    void reset(int level, uint64_t seed);
+
+    // One game tick at (x, y): direction to step (0 up, 1 down, 2 left,
+    // 3 right) or -1 to stay. toGoal must be the field of the current maze.
+    // graph, when given, must be built on it with findDeadBranches() run:
+    // the wall follower then treats dead branches as walls, so only its
+    // wrong turns still take it into one.
+    int tick(const Maze& maze, const DistanceField& toGoal, int x, int y, const JunctionGraph* graph = nullptr);
+
+    int level() const { return botLevel; }
+    int moves() const { return moveCount; }
+    int mistakes() const { return mistakeCount; }
+
+private:
+    int botLevel = BOT_PERFECT;
+    Rng rng;
+    int wait = 0;
+    int facing = -1;         // last step taken, -1 before the first
+    bool lost = false;       // took a wrong turn, not reading the field until the next junction
+    int moveCount = 0, mistakeCount = 0;
+    int giveUpAt = 0;        // wall follower: steps before it reads the field instead
+};
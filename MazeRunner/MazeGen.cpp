@@ -0,0 +1,402 @@
+#include "MazeGen.h"
+#include "MazeStream.h"
+#include "MazeParallel.h"
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// Movement offsets up, down, left, right
+int moveX[4] = { 0, 0, -2, 2 };
+int moveY[4] = { -2, 2, 0, 0 };
+
+void shuffleArray(int arr[], int n, Rng& rng) {
+    for (int i = n - 1; i > 0; i--) {
+        int j = (int)rng.below(i + 1);
+        int tmp = arr[i]; arr[i] = arr[j]; arr[j] = tmp;
+    }
+}
+
+// -------------------- CELL GRID HELPERS --------------------
+// The algorithms below work on the cell grid: cell (cx, cy) sits at grid
+// (2cx+1, 2cy+1) and cell index c = cy * cellsW + cx.
+int cellsWide(const Maze& maze) { return (maze.width - 1) / 2; }
+int cellsHigh(const Maze& maze) { return (maze.height - 1) / 2; }
+
+void openCell(Maze& maze, int cx, int cy) { maze.setWall(2 * cx + 1, 2 * cy + 1, false); }
+
+// opens the two cells and the wall between them (they must be neighbours)
+void carvePassage(Maze& maze, int cx1, int cy1, int cx2, int cy2) {
+    maze.setWall(2 * cx1 + 1, 2 * cy1 + 1, false);
+    maze.setWall(cx1 + cx2 + 1, cy1 + cy2 + 1, false);
+    maze.setWall(2 * cx2 + 1, 2 * cy2 + 1, false);
+}
+
+void finishMaze(Maze& maze) {
+    maze.setWall(maze.startX, maze.startY, false);
+    maze.setWall(maze.goalX, maze.goalY, false);
+}
+
+// Cell-step offsets up, down, left, right
+int cellDX[4] = { 0, 0, -1, 1 };
+int cellDY[4] = { -1, 1, 0, 0 };
+
+// -------------------- RANDOM WALK / DFS --------------------
+void generateMazeSimple(Maze& maze, Rng& rng) {
+    maze.fillAllWithWalls();
+
+    int x = maze.startX;
+    int y = maze.startY;
+    maze.setWall(x, y, false); // start position
+
+    bool madeProgress;
+    do {
+        madeProgress = false;
+        int dirs[4] = { 0,1,2,3 };
+        shuffleArray(dirs, 4, rng);
+
+        for (int i = 0; i < 4; i++) {
+            int d = dirs[i];
+            int nx = x + moveX[d];
+            int ny = y + moveY[d];
+
+            if (maze.insideBounds(nx, ny) && maze.isWall(nx, ny)) {
+                // knock down wall
+                maze.setWall(x + moveX[d] / 2, y + moveY[d] / 2, false);
+                maze.setWall(nx, ny, false);
+
+                x = nx;
+                y = ny;
+                madeProgress = true;
+                break; // take one step at a time
+            }
+        }
+
+        //  scan for any unvisited neighbor and jump to continue
+        if (!madeProgress) {
+            for (int ty = 1; ty < maze.height - 1; ty += 2) {
+                for (int tx = 1; tx < maze.width - 1; tx += 2) {
+                    if (!maze.isWall(tx, ty)) {
+                        bool hasWallNeighbor = false;
+                        for (int d = 0; d < 4; d++) {
+                            int nx = tx + moveX[d];
+                            int ny = ty + moveY[d];
+                            if (maze.insideBounds(nx, ny) && maze.isWall(nx, ny)) {
+                                hasWallNeighbor = true;
+                                break;
+                            }
+                        }
+                        if (hasWallNeighbor) {
+                            x = tx; y = ty;
+                            madeProgress = true;
+                            break;
+                        }
+                    }
+                }
+                if (madeProgress) break;
+            }
+        }
+
+    } while (madeProgress);
+
+    maze.setWall(maze.startX, maze.startY, false);
+    maze.setWall(maze.goalX, maze.goalY, false);
+}
+
+// Same perfect maze guarantees as generateMazeSimple, but on a dead end it pops
+// back to the previous cell instead of rescanning the grid, so every cell is
+// pushed and popped once: O(cells).
+void generateMazeStack(Maze& maze, Rng& rng) {
+    maze.fillAllWithWalls();
+
+    // one slot per cell is enough
+    vector<int> stackX((size_t)(maze.width / 2) * (maze.height / 2));
+    vector<int> stackY(stackX.size());
+
+    int top = 0;
+    maze.setWall(maze.startX, maze.startY, false);
+    stackX[top] = maze.startX; stackY[top] = maze.startY; top++;
+
+    while (top > 0) {
+        int x = stackX[top - 1];
+        int y = stackY[top - 1];
+
+        int dirs[4] = { 0,1,2,3 };
+        shuffleArray(dirs, 4, rng);
+
+        bool moved = false;
+        for (int i = 0; i < 4; i++) {
+            int d = dirs[i];
+            int nx = x + moveX[d];
+            int ny = y + moveY[d];
+
+            if (maze.insideBounds(nx, ny) && maze.isWall(nx, ny)) {
+                // knock down wall and push the new cell
+                maze.setWall(x + moveX[d] / 2, y + moveY[d] / 2, false);
+                maze.setWall(nx, ny, false);
+                stackX[top] = nx; stackY[top] = ny; top++;
+                moved = true;
+                break;
+            }
+        }
+
+        if (!moved) top--; // dead end: backtrack
+    }
+
+    maze.setWall(maze.startX, maze.startY, false);
+    maze.setWall(maze.goalX, maze.goalY, false);
+}
+
+// -------------------- KRUSKAL --------------------
+// Union-find over cells, path halving + union by size
+int findSet(vector<int>& parent, int c) {
+    while (parent[c] != c) {
+        parent[c] = parent[parent[c]];
+        c = parent[c];
+    }
+    return c;
+}
+
+bool unionSets(vector<int>& parent, vector<int>& size, int a, int b) {
+    a = findSet(parent, a);
+    b = findSet(parent, b);
+    if (a == b) return false;
+    if (size[a] < size[b]) { int t = a; a = b; b = t; }
+    parent[b] = a;
+    size[a] += size[b];
+    return true;
+}
+
+// Every wall between two cells is an edge (cell * 2 + 0 = east, + 1 = south).
+// Walk them in random order and knock down the ones joining two sets.
+void generateMazeKruskal(Maze& maze, Rng& rng) {
+    maze.fillAllWithWalls();
+    int cw = cellsWide(maze), ch = cellsHigh(maze);
+    int cells = cw * ch;
+
+    vector<int> parent(cells), size(cells, 1);
+    for (int c = 0; c < cells; c++) parent[c] = c;
+
+    vector<int> edges;
+    edges.reserve((size_t)cells * 2);
+    for (int cy = 0; cy < ch; cy++) {
+        for (int cx = 0; cx < cw; cx++) {
+            openCell(maze, cx, cy);
+            int c = cy * cw + cx;
+            if (cx + 1 < cw) edges.push_back(c * 2);
+            if (cy + 1 < ch) edges.push_back(c * 2 + 1);
+        }
+    }
+    for (int i = (int)edges.size() - 1; i > 0; i--) {
+        int j = (int)rng.below(i + 1);
+        int tmp = edges[i]; edges[i] = edges[j]; edges[j] = tmp;
+    }
+
+    int joined = 0;
+    for (size_t i = 0; i < edges.size() && joined < cells - 1; i++) {
+        int c = edges[i] / 2;
+        int cx = c % cw, cy = c / cw;
+        int nx = cx, ny = cy;
+        if (edges[i] % 2 == 0) nx++; else ny++;
+        if (unionSets(parent, size, c, ny * cw + nx)) {
+            carvePassage(maze, cx, cy, nx, ny);
+            joined++;
+        }
+    }
+
+    finishMaze(maze);
+}
+
+// -------------------- PRIM --------------------
+// Randomized Prim: grow from the start cell, each step joins a random
+// frontier cell to a random neighbour that is already in the maze.
+void generateMazePrim(Maze& maze, Rng& rng) {
+    maze.fillAllWithWalls();
+    int cw = cellsWide(maze), ch = cellsHigh(maze);
+
+    const unsigned char OUT = 0, FRONTIER = 1, IN = 2;
+    vector<unsigned char> state((size_t)cw * ch, OUT);
+    vector<int> frontier;
+
+    int sx = (maze.startX - 1) / 2, sy = (maze.startY - 1) / 2;
+    state[sy * cw + sx] = IN;
+    openCell(maze, sx, sy);
+    for (int d = 0; d < 4; d++) {
+        int nx = sx + cellDX[d], ny = sy + cellDY[d];
+        if (nx >= 0 && nx < cw && ny >= 0 && ny < ch) { state[ny * cw + nx] = FRONTIER; frontier.push_back(ny * cw + nx); }
+    }
+
+    while (!frontier.empty()) {
+        // swap-remove a random frontier cell
+        int i = (int)rng.below((int)frontier.size());
+        int c = frontier[i];
+        frontier[i] = frontier.back();
+        frontier.pop_back();
+
+        int cx = c % cw, cy = c / cw;
+        int inDirs[4], inCount = 0;
+        for (int d = 0; d < 4; d++) {
+            int nx = cx + cellDX[d], ny = cy + cellDY[d];
+            if (nx < 0 || nx >= cw || ny < 0 || ny >= ch) continue;
+            int n = ny * cw + nx;
+            if (state[n] == IN) inDirs[inCount++] = d;
+            else if (state[n] == OUT) { state[n] = FRONTIER; frontier.push_back(n); }
+        }
+
+        int d = inDirs[(int)rng.below(inCount)];
+        carvePassage(maze, cx, cy, cx + cellDX[d], cy + cellDY[d]);
+        state[c] = IN;
+    }
+
+    finishMaze(maze);
+}
+
+// -------------------- WILSON --------------------
+// Loop-erased random walks: uniform spanning tree (every perfect maze equally
+// likely). The walk remembers only the last exit direction of each cell, so
+// loops erase themselves when a cell is revisited.
+void generateMazeWilson(Maze& maze, Rng& rng) {
+    maze.fillAllWithWalls();
+    int cw = cellsWide(maze), ch = cellsHigh(maze);
+    int cells = cw * ch;
+
+    vector<unsigned char> inTree(cells, 0);
+    vector<unsigned char> exitDir(cells, 0);
+
+    int root = (int)rng.below(cells);
+    inTree[root] = 1;
+    openCell(maze, root % cw, root / cw);
+
+    for (int first = 0; first < cells; first++) {
+        if (inTree[first]) continue;
+
+        // random walk until it hits the tree
+        int c = first;
+        while (!inTree[c]) {
+            int cx = c % cw, cy = c / cw;
+            int d, nx, ny;
+            do {
+                d = (int)rng.below(4);
+                nx = cx + cellDX[d]; ny = cy + cellDY[d];
+            } while (nx < 0 || nx >= cw || ny < 0 || ny >= ch);
+            exitDir[c] = (unsigned char)d;
+            c = ny * cw + nx;
+        }
+
+        // retrace the loop-erased path and add it to the tree
+        c = first;
+        while (!inTree[c]) {
+            int cx = c % cw, cy = c / cw;
+            int d = exitDir[c];
+            int nx = cx + cellDX[d], ny = cy + cellDY[d];
+            carvePassage(maze, cx, cy, nx, ny);
+            inTree[c] = 1;
+            c = ny * cw + nx;
+        }
+    }
+
+    finishMaze(maze);
+}
+
+// -------------------- GROWING TREE --------------------
+const char* const GT_POLICY_IDS[GT_POLICY_COUNT] = { "newest", "random", "oldest", "mixed" };
+
+int findGrowingTreePolicy(const string& id) {
+    for (int p = 0; p < GT_POLICY_COUNT; p++)
+        if (id == GT_POLICY_IDS[p]) return p;
+    return -1;
+}
+
+// Keeps a list of active cells. Picking the newest makes it a backtracker
+// (long corridors), picking a random one makes it Prim-like (short branches).
+void generateMazeGrowingTree(Maze& maze, int policy, int newestPercent, Rng& rng) {
+    maze.fillAllWithWalls();
+    int cw = cellsWide(maze), ch = cellsHigh(maze);
+
+    vector<unsigned char> visited((size_t)cw * ch, 0);
+    vector<int> active;
+    size_t head = 0; // cells before head were removed from the front (oldest policy)
+
+    int sx = (maze.startX - 1) / 2, sy = (maze.startY - 1) / 2;
+    visited[sy * cw + sx] = 1;
+    openCell(maze, sx, sy);
+    active.push_back(sy * cw + sx);
+
+    while (head < active.size()) {
+        size_t count = active.size() - head;
+        size_t i;
+        if (policy == GT_NEWEST) i = active.size() - 1;
+        else if (policy == GT_OLDEST) i = head;
+        else if (policy == GT_RANDOM) i = head + (int)rng.below((int)count);
+        else i = ((int)rng.below(100) < newestPercent) ? active.size() - 1 : head + (int)rng.below((int)count);
+
+        int c = active[i];
+        int cx = c % cw, cy = c / cw;
+
+        int dirs[4] = { 0,1,2,3 };
+        shuffleArray(dirs, 4, rng);
+        bool carved = false;
+        for (int k = 0; k < 4; k++) {
+            int nx = cx + cellDX[dirs[k]], ny = cy + cellDY[dirs[k]];
+            if (nx < 0 || nx >= cw || ny < 0 || ny >= ch || visited[ny * cw + nx]) continue;
+            carvePassage(maze, cx, cy, nx, ny);
+            visited[ny * cw + nx] = 1;
+            active.push_back(ny * cw + nx);
+            carved = true;
+            break;
+        }
+
+        if (!carved) {
+            // cell is done: drop it
+            if (i == head) head++;
+            else { active[i] = active.back(); active.pop_back(); }
+        }
+    }
+
+    finishMaze(maze);
+}
+
+// table entry: generateMaze has put the options on the maze
+void generateMazeGrowingTreeOptions(Maze& maze, Rng& rng) {
+    generateMazeGrowingTree(maze, maze.options.treePolicy, maze.options.treeNewestPercent, rng);
+}
+
+// -------------------- ELLER --------------------
+// Same code as the streaming generator, with the rows poured into the maze
+void generateMazeEller(Maze& maze, Rng& rng) {
+    MazeFillSink sink(maze);
+    generateEllerStream(maze.width, maze.height, sink, rng.next());
+    finishMaze(maze);
+}
+
+// -------------------- GENERATOR TABLE --------------------
+const MazeGenerator MAZE_GENERATORS[GEN_COUNT] = {
+    { "simple", "Simple (rescan)", generateMazeSimple },
+    { "stack", "Stack DFS", generateMazeStack },
+    { "kruskal", "Kruskal", generateMazeKruskal },
+    { "prim", "Prim", generateMazePrim },
+    { "wilson", "Wilson", generateMazeWilson },
+    { "growing-tree", "Growing Tree", generateMazeGrowingTreeOptions },
+    { "eller", "Eller", generateMazeEller },
+    { "tiled", "Tiled (parallel)", generateMazeTiledDefault },
+};
+
+void generateMaze(Maze& maze, int gen, uint64_t seed, const GenOptions& options) {
+    if (gen < 0 || gen >= GEN_COUNT) gen = GEN_STACK;
+    maze.options = (gen == GEN_GROWING_TREE) ? options : GenOptions();
+    Rng rng(seed);
+    MAZE_GENERATORS[gen].generate(maze, rng);
+    maze.seed = seed;
+    maze.generator = gen;
+}
+
+const char* generatorName(int gen) {
+    if (gen < 0 || gen >= GEN_COUNT) return "Unknown";
+    return MAZE_GENERATORS[gen].name;
+}
+
+int findGenerator(const string& id) {
+    for (int g = 0; g < GEN_COUNT; g++)
+        if (id == MAZE_GENERATORS[g].id) return g;
+    return -1;
+}
@@ -0,0 +1,62 @@
+#pragma once
+#include <string>
+#include <vector>
+#include "Maze.h"
+#include "Rng.h"
+
+// Maze generators (ids index MAZE_GENERATORS)
+const int GEN_SIMPLE = 0;       // random walk + full grid rescan (old)
+const int GEN_STACK = 1;        // depth-first backtracker with explicit stack
+const int GEN_KRUSKAL = 2;      // random edge order + union-find
+const int GEN_PRIM = 3;         // randomized Prim
+const int GEN_WILSON = 4;       // loop-erased random walks (uniform)
+const int GEN_GROWING_TREE = 5; // growing tree, policy from the maze's GenOptions
+const int GEN_ELLER = 6;        // row by row, O(width) state
+const int GEN_TILED = 7;        // tiles carved on all cores, then stitched
+const int GEN_COUNT = 8;
+
+// Generator interface: every algorithm fills the whole Maze with a perfect
+// maze for its current size, leaving start and goal open. All randomness
+// comes from rng, so the same seed always gives the same maze.
+typedef void (*MazeGenFunc)(Maze& maze, Rng& rng);
+
+struct MazeGenerator {
+    const char* id;    // short name for the command line
+    const char* name;  // shown in the menu
+    MazeGenFunc generate;
+};
+
+extern const MazeGenerator MAZE_GENERATORS[GEN_COUNT];
+
+void generateMazeSimple(Maze& maze, Rng& rng);
+void generateMazeStack(Maze& maze, Rng& rng);
+void generateMazeKruskal(Maze& maze, Rng& rng);
+void generateMazePrim(Maze& maze, Rng& rng);
+void generateMazeWilson(Maze& maze, Rng& rng);
+void generateMazeEller(Maze& maze, Rng& rng);
+
+// Growing tree cell picking policy
+const int GT_NEWEST = 0;  // backtracker-like, long corridors
+const int GT_RANDOM = 1;  // Prim-like, lots of short dead ends
+const int GT_OLDEST = 2;  // long straight runs
+const int GT_MIXED = 3;   // newest with GenOptions::treeNewestPercent, else random
+const int GT_POLICY_COUNT = 4;
+static_assert(GenOptions().treePolicy == GT_MIXED, "GenOptions defaults to the mixed policy");
+extern const char* const GT_POLICY_IDS[GT_POLICY_COUNT]; // "newest", "random", ... by GT_* id
+int findGrowingTreePolicy(const std::string& id); // -1 when unknown
+void generateMazeGrowingTree(Maze& maze, int policy, int newestPercent, Rng& rng);
+
+// Shared helpers. Cell (cx, cy) sits at grid (2cx+1, 2cy+1).
+int cellsWide(const Maze& maze);
+int cellsHigh(const Maze& maze);
+void carvePassage(Maze& maze, int cx1, int cy1, int cx2, int cy2); // neighbours only
+void finishMaze(Maze& maze);                      // opens start and goal
+void shuffleArray(int arr[], int n, Rng& rng);
+int findSet(std::vector<int>& parent, int c);     // union-find root, path halving
+
+// Dispatches on one of the GEN_* ids and records seed/generator/options on
+// the maze (options only matter to the growing tree; other mazes keep the
+// defaults)
+void generateMaze(Maze& maze, int gen, uint64_t seed, const GenOptions& options = GenOptions());
+const char* generatorName(int gen);
+int findGenerator(const std::string& id); // -1 when unknown
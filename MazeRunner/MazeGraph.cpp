@@ -0,0 +1,289 @@
+#include "MazeGraph.h"
+#include <algorithm>
+#include <climits>
+#include <cstdlib>
+
+using namespace std;
+
+// up, down, left, right; d ^ 1 is the opposite direction
+static const int stepX[4] = { 0, 0, -1, 1 };
+static const int stepY[4] = { -1, 1, 0, 0 };
+
+// -------------------- NODES --------------------
+bool JunctionGraph::isNodeCell(const Maze& maze, int x, int y) const {
+    if (!maze.isOpen(x, y)) return false;
+    int c = y * width + x;
+    if (c == startCell || c == goalCell) return true;
+    int open = maze.isOpen(x, y - 1) + maze.isOpen(x, y + 1) + maze.isOpen(x - 1, y) + maze.isOpen(x + 1, y);
+    return open != 2;
+}
+
+int JunctionGraph::addNode(int x, int y) {
+    int n;
+    if (!freeNodes.empty()) { n = freeNodes.back(); freeNodes.pop_back(); nodes[n] = { x, y, true }; }
+    else { n = (int)nodes.size(); nodes.push_back({ x, y, true }); }
+    nodeOfCell[y * width + x] = n;
+    aliveNodes++;
+    return n;
+}
+
+void JunctionGraph::removeNode(int n) {
+    nodeOfCell.erase(nodes[n].y * width + nodes[n].x);
+    nodes[n].alive = false;
+    freeNodes.push_back(n);
+    aliveNodes--;
+}
+
+int JunctionGraph::nodeAt(int x, int y) const {
+    auto it = nodeOfCell.find(y * width + x);
+    return it == nodeOfCell.end() ? -1 : it->second;
+}
+
+// -------------------- CORRIDORS --------------------
+// Follows the corridor leaving node n in direction dir to the node at its
+// other end. Each corridor end (node, direction) is walked once: both ends
+// go into claimed.
+void JunctionGraph::walkFrom(const Maze& maze, int n, int dir, unordered_set<long long>& claimed) {
+    if (claimed.count((long long)n * 4 + dir)) return;
+    int x = nodes[n].x, y = nodes[n].y;
+    if (!maze.isOpen(x + stepX[dir], y + stepY[dir])) return;
+
+    Corridor c = { n, -1, 0, (uint8_t)dir, 0, x, y, x, y, true };
+    int d = dir;
+    while (true) {
+        x += stepX[d]; y += stepY[d];
+        c.length++;
+        c.minX = min(c.minX, x); c.maxX = max(c.maxX, x);
+        c.minY = min(c.minY, y); c.maxY = max(c.maxY, y);
+        if (isNodeCell(maze, x, y)) break;
+        // corridor cell: the one open side that is not back
+        for (int k = 0; k < 4; k++)
+            if (k != (d ^ 1) && maze.isOpen(x + stepX[k], y + stepY[k])) { d = k; break; }
+    }
+    c.b = nodeAt(x, y);
+    c.dirB = (uint8_t)(d ^ 1);
+    claimed.insert((long long)n * 4 + dir);
+    claimed.insert((long long)c.b * 4 + c.dirB);
+    if (c.b == n) return; // a loop back to the same junction is never shorter
+
+    if (!freeCorridors.empty()) { corridors[freeCorridors.back()] = c; freeCorridors.pop_back(); }
+    else corridors.push_back(c);
+    aliveCorridors++;
+}
+
+void JunctionGraph::rebuildCsr() {
+    int count = (int)nodes.size();
+    adjStart.assign(count + 1, 0);
+    for (const Corridor& c : corridors) {
+        if (!c.alive) continue;
+        adjStart[c.a + 1]++;
+        adjStart[c.b + 1]++;
+    }
+    for (int n = 0; n < count; n++) adjStart[n + 1] += adjStart[n];
+    adjTo.resize(adjStart[count]);
+    adjLength.resize(adjStart[count]);
+    adjDir.resize(adjStart[count]);
+
+    vector<int> pos(adjStart.begin(), adjStart.end() - 1);
+    for (const Corridor& c : corridors) {
+        if (!c.alive) continue;
+        int i = pos[c.a]++;
+        adjTo[i] = c.b; adjLength[i] = c.length; adjDir[i] = c.dirA;
+        i = pos[c.b]++;
+        adjTo[i] = c.a; adjLength[i] = c.length; adjDir[i] = c.dirB;
+    }
+}
+
+// -------------------- BUILD / UPDATE --------------------
+void JunctionGraph::build(const Maze& maze) {
+    width = maze.width;
+    nodes.clear();
+    corridors.clear();
+    freeNodes.clear();
+    freeCorridors.clear();
+    nodeOfCell.clear();
+    nodeOfCell.reserve((size_t)maze.width * maze.height / 8);
+    aliveNodes = 0;
+    aliveCorridors = 0;
+    updateRegion(maze, 0, 0, maze.width - 1, maze.height - 1);
+}
+
+void JunctionGraph::updateRegion(const Maze& maze, int x0, int y0, int x1, int y1) {
+    width = maze.width;
+    startCell = maze.startY * width + maze.startX;
+    goalCell = maze.goalY * width + maze.goalX;
+
+    // a changed wall also changes its neighbours' open count
+    x0 = max(x0 - 1, 0); y0 = max(y0 - 1, 0);
+    x1 = min(x1 + 1, maze.width - 1); y1 = min(y1 + 1, maze.height - 1);
+    auto inside = [&](int x, int y) { return x >= x0 && x <= x1 && y >= y0 && y <= y1; };
+
+    // drop every corridor touching the box; ends outside it walk again
+    vector<pair<int, int>> rewalk;
+    for (size_t i = 0; i < corridors.size(); i++) {
+        Corridor& c = corridors[i];
+        if (!c.alive || c.maxX < x0 || c.minX > x1 || c.maxY < y0 || c.minY > y1) continue;
+        c.alive = false;
+        freeCorridors.push_back((int)i);
+        aliveCorridors--;
+        if (!inside(nodes[c.a].x, nodes[c.a].y)) rewalk.push_back({ c.a, c.dirA });
+        if (!inside(nodes[c.b].x, nodes[c.b].y)) rewalk.push_back({ c.b, c.dirB });
+    }
+
+    // nodes inside the box are rebuilt from the current walls
+    vector<int> added;
+    for (int y = y0; y <= y1; y++) {
+        for (int x = x0; x <= x1; x++) {
+            int n = nodeAt(x, y);
+            if (n >= 0) removeNode(n);
+        }
+    }
+    for (int y = y0; y <= y1; y++)
+        for (int x = x0; x <= x1; x++)
+            if (isNodeCell(maze, x, y)) added.push_back(addNode(x, y));
+
+    unordered_set<long long> claimed;
+    for (int n : added)
+        for (int d = 0; d < 4; d++) walkFrom(maze, n, d, claimed);
+    for (auto& r : rewalk) walkFrom(maze, r.first, r.second, claimed);
+
+    rebuildCsr();
+    deadNode.clear();
+    deadCells = 0;
+}
+
+// -------------------- QUERIES --------------------
+static uint64_t graphKey(uint32_t f, uint32_t g) {
+    return ((uint64_t)f << 32) | (uint32_t)~g;
+}
+
+int JunctionGraph::distance(const Maze& maze, int sx, int sy, int tx, int ty, int* firstDir) {
+    if (firstDir) *firstDir = -1;
+    if (!maze.isOpen(sx, sy) || !maze.isOpen(tx, ty)) return -1;
+    if (sx == tx && sy == ty) return 0;
+
+    if (stamp.size() < nodes.size()) { stamp.resize(nodes.size(), 0); g.resize(nodes.size()); first.resize(nodes.size()); }
+    if (++queryStamp == 0) { fill(stamp.begin(), stamp.end(), 0); queryStamp = 1; }
+
+    // walks a corridor from (x, y) in direction d to the next node cell,
+    // noting when it passes the target; -1 on a loop with no node on it
+    auto follow = [&](int x, int y, int d, int& steps, int& hitAt, int& lastDir) {
+        int ox = x, oy = y;
+        steps = 0; hitAt = -1;
+        while (true) {
+            x += stepX[d]; y += stepY[d];
+            steps++;
+            if (x == tx && y == ty && hitAt < 0) hitAt = steps;
+            if (x == ox && y == oy) return -1;
+            if (isNodeCell(maze, x, y)) break;
+            for (int k = 0; k < 4; k++)
+                if (k != (d ^ 1) && maze.isOpen(x + stepX[k], y + stepY[k])) { d = k; break; }
+        }
+        lastDir = d;
+        return nodeAt(x, y);
+    };
+
+    // target side: the node(s) at the ends of its corridor, with the cost
+    // to the target and the direction from that node towards it
+    int goalNode[2], goalCost[2], goalDir[2], goals = 0;
+    int t = nodeAt(tx, ty);
+    if (t >= 0) { goalNode[0] = t; goalCost[0] = 0; goalDir[0] = -1; goals = 1; }
+    else {
+        for (int d = 0; d < 4 && goals < 2; d++) {
+            if (!maze.isOpen(tx + stepX[d], ty + stepY[d])) continue;
+            int steps, hit, last = 0;
+            int n = follow(tx, ty, d, steps, hit, last);
+            goalNode[goals] = n; goalCost[goals] = steps; goalDir[goals] = last ^ 1; goals++;
+        }
+    }
+
+    int best = INT_MAX, bestFirst = -1;
+    auto later = [](const OpenNode& a, const OpenNode& b) { return a.key > b.key; };
+    auto push = [&](int n, int cost, int dir) {
+        if (n < 0 || (stamp[n] == queryStamp && g[n] <= cost)) return;
+        stamp[n] = queryStamp; g[n] = cost; first[n] = dir;
+        open.push_back({ graphKey(cost + abs(nodes[n].x - tx) + abs(nodes[n].y - ty), cost), n });
+        push_heap(open.begin(), open.end(), later);
+    };
+    open.clear();
+
+    // start side: itself, or both ends of its corridor
+    int s = nodeAt(sx, sy);
+    if (s >= 0) push(s, 0, -1);
+    else {
+        for (int d = 0; d < 4; d++) {
+            if (!maze.isOpen(sx + stepX[d], sy + stepY[d])) continue;
+            int steps, hit, last = 0;
+            int n = follow(sx, sy, d, steps, hit, last);
+            if (hit >= 0 && hit < best) { best = hit; bestFirst = d; }
+            push(n, steps, d);
+        }
+    }
+
+    while (!open.empty()) {
+        uint32_t f = (uint32_t)(open.front().key >> 32);
+        uint32_t gu = ~(uint32_t)open.front().key;
+        int u = open.front().node;
+        pop_heap(open.begin(), open.end(), later);
+        open.pop_back();
+        if ((int)gu != g[u]) continue;
+        if ((long long)f >= best) break;
+
+        for (int i = 0; i < goals; i++) {
+            if (goalNode[i] != u || g[u] + goalCost[i] >= best) continue;
+            best = g[u] + goalCost[i];
+            bestFirst = first[u] >= 0 ? first[u] : goalDir[i];
+        }
+        for (int e = adjStart[u]; e < adjStart[u + 1]; e++)
+            push(adjTo[e], g[u] + adjLength[e], first[u] >= 0 ? first[u] : adjDir[e]);
+    }
+
+    if (best == INT_MAX) return -1;
+    if (firstDir) *firstDir = bestFirst;
+    return best;
+}
+
+// -------------------- DEAD BRANCHES --------------------
+void JunctionGraph::findDeadBranches() {
+    int count = (int)nodes.size();
+    deadNode.assign(count, 0);
+    deadCells = 0;
+
+    vector<int> degree(count), leaves;
+    for (int n = 0; n < count; n++) {
+        if (!nodes[n].alive) continue;
+        degree[n] = adjStart[n + 1] - adjStart[n];
+        int c = nodes[n].y * width + nodes[n].x;
+        if (degree[n] <= 1 && c != startCell && c != goalCell) leaves.push_back(n);
+    }
+    while (!leaves.empty()) {
+        int u = leaves.back();
+        leaves.pop_back();
+        deadNode[u] = 1;
+        deadCells++;
+        for (int e = adjStart[u]; e < adjStart[u + 1]; e++) {
+            int v = adjTo[e];
+            if (deadNode[v]) continue;
+            deadCells += adjLength[e] - 1; // corridor cells in between
+            int c = nodes[v].y * width + nodes[v].x;
+            if (--degree[v] == 1 && c != startCell && c != goalCell) leaves.push_back(v);
+        }
+    }
+}
+
+int JunctionGraph::deadEndCount() const {
+    int count = 0;
+    for (size_t n = 0; n < nodes.size(); n++) {
+        if (!nodes[n].alive) continue;
+        int c = nodes[n].y * width + nodes[n].x;
+        if (adjStart[n + 1] - adjStart[n] == 1 && c != startCell && c != goalCell) count++;
+    }
+    return count;
+}
+
+size_t JunctionGraph::memoryBytes() const {
+    // unordered_map: roughly a bucket pointer plus a node per entry
+    return nodes.capacity() * sizeof(Node) + corridors.capacity() * sizeof(Corridor) +
+        nodeOfCell.size() * (sizeof(void*) * 2 + sizeof(pair<int, int>)) + nodeOfCell.bucket_count() * sizeof(void*) +
+        (adjStart.capacity() + adjTo.capacity() + adjLength.capacity()) * sizeof(int) + adjDir.capacity();
+}
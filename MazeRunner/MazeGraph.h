@@ -0,0 +1,92 @@
+#pragma once
+#include <cstdint>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "Maze.h"
+
+// -------------------- JUNCTION GRAPH --------------------
+// Most open cells are corridor cells with exactly two open neighbours. This
+// keeps only the others (junctions, dead ends, plus start and goal) as nodes
+// and turns each corridor between them into one edge weighted by its length.
+// Adjacency is kept in CSR arrays: node n's edges are
+// [adjStart[n], adjStart[n + 1]) in adjTo / adjLength / adjDir.
+//
+// A corridor loop with no junction on it has no node and is left out.
+class JunctionGraph {
+public:
+    void build(const Maze& maze);
+
+    // Walls changed somewhere inside [x0, x1] x [y0, y1] (grid cells): only
+    // the corridors running through that box are walked again.
+    void updateRegion(const Maze& maze, int x0, int y0, int x1, int y1);
+
+    // Steps between two open cells, -1 if there is no path. firstDir, when
+    // given, receives the first move from (sx, sy): 0 up, 1 down, 2 left,
+    // 3 right (-1 when already there or no path).
+    int distance(const Maze& maze, int sx, int sy, int tx, int ty, int* firstDir = nullptr);
+
+    // Node at a grid cell, -1 for corridor cells and walls
+    int nodeAt(int x, int y) const;
+    int nodeX(int n) const { return nodes[n].x; }
+    int nodeY(int n) const { return nodes[n].y; }
+
+    // Edges of node n are [edgeBegin(n), edgeEnd(n)); edgeDir is the
+    // direction of the first step out of n
+    int edgeBegin(int n) const { return adjStart[n]; }
+    int edgeEnd(int n) const { return adjStart[n + 1]; }
+    int edgeTo(int e) const { return adjTo[e]; }
+    int edgeLength(int e) const { return adjLength[e]; }
+    int edgeDir(int e) const { return adjDir[e]; }
+
+    // Leaves are pruned over and over (start and goal are never pruned):
+    // whatever goes is a dead branch that cannot be on any start -> goal path.
+    void findDeadBranches();
+    bool isDeadBranch(int n) const { return n >= 0 && n < (int)deadNode.size() && deadNode[n]; }
+    long long deadBranchCells() const { return deadCells; }
+
+    int nodeCount() const { return aliveNodes; }
+    long long edgeCount() const { return aliveCorridors; }
+    int deadEndCount() const;
+    size_t memoryBytes() const;
+
+private:
+    struct Node {
+        int x, y;
+        bool alive;
+    };
+    struct Corridor {
+        int a, b, length;
+        uint8_t dirA, dirB;         // first step out of a / out of b
+        int minX, minY, maxX, maxY; // bounding box, endpoints included
+        bool alive;
+    };
+
+    int width = 0;
+    int startCell = -1, goalCell = -1;
+    std::vector<Node> nodes;
+    std::vector<Corridor> corridors;
+    std::vector<int> freeNodes, freeCorridors;
+    std::unordered_map<int, int> nodeOfCell;
+    int aliveNodes = 0;
+    long long aliveCorridors = 0;
+
+    std::vector<int> adjStart, adjTo, adjLength;
+    std::vector<uint8_t> adjDir;    // direction of the first step out of the node
+
+    std::vector<uint8_t> deadNode;
+    long long deadCells = 0;
+
+    // query scratch (stamp == current query means valid)
+    std::vector<uint32_t> stamp;
+    std::vector<int> g, first;
+    uint32_t queryStamp = 0;
+    struct OpenNode { uint64_t key; int node; };
+    std::vector<OpenNode> open;
+
+    bool isNodeCell(const Maze& maze, int x, int y) const;
+    int addNode(int x, int y);
+    void removeNode(int n);
+    void walkFrom(const Maze& maze, int n, int dir, std::unordered_set<long long>& claimed);
+    void rebuildCsr();
+};
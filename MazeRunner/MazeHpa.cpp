@@ -0,0 +1,254 @@
+#include "MazeHpa.h"
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <cstdlib>
+#include <thread>
+#include <unordered_map>
+
+using namespace std;
+
+// -------------------- CLUSTER BFS --------------------
+// BFS that never leaves the rectangle [x0, x1) x [y0, y1)
+struct ClusterBfs {
+    int x0 = 0, y0 = 0, w = 0, h = 0;
+    vector<int> dist, queue;
+    vector<uint8_t> dir;
+
+    void run(const Maze& maze, int rx0, int ry0, int rx1, int ry1, int sx, int sy) {
+        static const int dx[4] = { 0, 0, -1, 1 };
+        static const int dy[4] = { -1, 1, 0, 0 };
+        x0 = rx0; y0 = ry0; w = rx1 - rx0; h = ry1 - ry0;
+        dist.assign((size_t)w * h, -1);
+        dir.resize((size_t)w * h);
+        queue.clear();
+
+        int s = (sy - y0) * w + (sx - x0);
+        dist[s] = 0;
+        queue.push_back(s);
+        for (size_t head = 0; head < queue.size(); head++) {
+            int c = queue[head];
+            int lx = c % w, ly = c / w;
+            for (int k = 0; k < 4; k++) {
+                int nx = lx + dx[k], ny = ly + dy[k];
+                if (nx < 0 || nx >= w || ny < 0 || ny >= h) continue;
+                if (maze.isWall(x0 + nx, y0 + ny)) continue;
+                int n = ny * w + nx;
+                if (dist[n] >= 0) continue;
+                dist[n] = dist[c] + 1;
+                dir[n] = (uint8_t)k;
+                queue.push_back(n);
+            }
+        }
+    }
+
+    int at(int x, int y) const { return dist[(y - y0) * w + (x - x0)]; }
+
+    // grid indices from the BFS source to (x, y), appended to out
+    void pathTo(int x, int y, int mazeW, vector<int>& out) const {
+        static const int dx[4] = { 0, 0, -1, 1 };
+        static const int dy[4] = { -1, 1, 0, 0 };
+        size_t first = out.size();
+        out.resize(first + at(x, y) + 1);
+        for (size_t i = out.size() - 1;; i--) {
+            out[i] = y * mazeW + x;
+            if (i == first) break;
+            int k = dir[(y - y0) * w + (x - x0)];
+            x -= dx[k]; y -= dy[k];
+        }
+    }
+};
+
+void HpaGraph::clusterRect(int c, int& x0, int& y0, int& x1, int& y1) const {
+    x0 = (c % clustersX) * clusterSize;
+    y0 = (c / clustersX) * clusterSize;
+    x1 = min(x0 + clusterSize, width);
+    y1 = min(y0 + clusterSize, height);
+}
+
+size_t HpaGraph::memoryBytes() const {
+    return (nodeX.capacity() + nodeY.capacity() + clusterStart.capacity() + edgeStart.capacity() +
+        edgeTo.capacity() + edgeCost.capacity() + g.capacity() + parent.capacity() + goalCost.capacity()) * sizeof(int) +
+        stamp.capacity() * sizeof(uint32_t) + open.capacity() * sizeof(OpenNode);
+}
+
+// -------------------- BUILD --------------------
+void HpaGraph::build(const Maze& maze, int size, int threads) {
+    width = maze.width;
+    height = maze.height;
+    clusterSize = max(size, 4);
+    clustersX = (width + clusterSize - 1) / clusterSize;
+    clustersY = (height + clusterSize - 1) / clusterSize;
+    int clusters = clustersX * clustersY;
+
+    // entrances: both cells of every open pair across a cluster border
+    vector<int> tmpX, tmpY, inter;
+    unordered_map<long long, int> cellNode;
+    auto nodeAt = [&](int x, int y) {
+        long long key = (long long)y * width + x;
+        auto it = cellNode.find(key);
+        if (it != cellNode.end()) return it->second;
+        int id = (int)tmpX.size();
+        cellNode[key] = id;
+        tmpX.push_back(x);
+        tmpY.push_back(y);
+        return id;
+    };
+    for (int bx = clusterSize; bx < width; bx += clusterSize)
+        for (int y = 0; y < height; y++)
+            if (maze.isOpen(bx - 1, y) && maze.isOpen(bx, y)) { inter.push_back(nodeAt(bx - 1, y)); inter.push_back(nodeAt(bx, y)); }
+    for (int by = clusterSize; by < height; by += clusterSize)
+        for (int x = 0; x < width; x++)
+            if (maze.isOpen(x, by - 1) && maze.isOpen(x, by)) { inter.push_back(nodeAt(x, by - 1)); inter.push_back(nodeAt(x, by)); }
+
+    // group nodes by cluster (counting sort)
+    int nodes = (int)tmpX.size();
+    clusterStart.assign(clusters + 1, 0);
+    for (int n = 0; n < nodes; n++) clusterStart[clusterOf(tmpX[n], tmpY[n]) + 1]++;
+    for (int c = 0; c < clusters; c++) clusterStart[c + 1] += clusterStart[c];
+    vector<int> remap(nodes), fill(clusterStart.begin(), clusterStart.end() - 1);
+    nodeX.resize(nodes);
+    nodeY.resize(nodes);
+    for (int n = 0; n < nodes; n++) {
+        int id = fill[clusterOf(tmpX[n], tmpY[n])]++;
+        remap[n] = id;
+        nodeX[id] = tmpX[n];
+        nodeY[id] = tmpY[n];
+    }
+
+    // intra-cluster distances: one BFS per entrance, clusters spread over threads
+    vector<vector<int>> intra(clusters); // triples: from, to, cost
+    if (threads <= 0) threads = (int)thread::hardware_concurrency();
+    if (threads <= 0) threads = 1;
+    if (threads > clusters) threads = clusters;
+    atomic<int> nextCluster(0);
+    auto worker = [&]() {
+        ClusterBfs bfs;
+        for (int c = nextCluster++; c < clusters; c = nextCluster++) {
+            int x0, y0, x1, y1;
+            clusterRect(c, x0, y0, x1, y1);
+            for (int a = clusterStart[c]; a < clusterStart[c + 1]; a++) {
+                bfs.run(maze, x0, y0, x1, y1, nodeX[a], nodeY[a]);
+                for (int b = clusterStart[c]; b < clusterStart[c + 1]; b++) {
+                    int d = bfs.at(nodeX[b], nodeY[b]);
+                    if (b == a || d < 0) continue;
+                    intra[c].push_back(a);
+                    intra[c].push_back(b);
+                    intra[c].push_back(d);
+                }
+            }
+        }
+    };
+    vector<thread> pool;
+    for (int i = 1; i < threads; i++) pool.emplace_back(worker);
+    worker();
+    for (size_t i = 0; i < pool.size(); i++) pool[i].join();
+
+    // CSR: intra edges, then the 1-step border crossings both ways
+    edgeStart.assign(nodes + 1, 0);
+    for (int c = 0; c < clusters; c++)
+        for (size_t i = 0; i < intra[c].size(); i += 3) edgeStart[intra[c][i] + 1]++;
+    for (size_t i = 0; i < inter.size(); i += 2) { edgeStart[remap[inter[i]] + 1]++; edgeStart[remap[inter[i + 1]] + 1]++; }
+    for (int n = 0; n < nodes; n++) edgeStart[n + 1] += edgeStart[n];
+    edgeTo.resize(edgeStart[nodes]);
+    edgeCost.resize(edgeStart[nodes]);
+    vector<int> pos(edgeStart.begin(), edgeStart.end() - 1);
+    auto addEdge = [&](int a, int b, int cost) { edgeTo[pos[a]] = b; edgeCost[pos[a]++] = cost; };
+    for (int c = 0; c < clusters; c++)
+        for (size_t i = 0; i < intra[c].size(); i += 3) addEdge(intra[c][i], intra[c][i + 1], intra[c][i + 2]);
+    for (size_t i = 0; i < inter.size(); i += 2) {
+        int a = remap[inter[i]], b = remap[inter[i + 1]];
+        addEdge(a, b, 1);
+        addEdge(b, a, 1);
+    }
+
+    stamp.assign(nodes, 0);
+    g.resize(nodes);
+    parent.resize(nodes);
+    goalCost.resize(nodes);
+    queryStamp = 0;
+}
+
+// -------------------- QUERY --------------------
+static uint64_t hpaKey(uint32_t f, uint32_t g) {
+    return ((uint64_t)f << 32) | (uint32_t)~g;
+}
+
+int HpaGraph::query(const Maze& maze, int sx, int sy, int tx, int ty, vector<int>* path) {
+    expandedCount = 0;
+    if (!maze.isOpen(sx, sy) || !maze.isOpen(tx, ty)) return -1;
+    if (++queryStamp == 0) { fill(stamp.begin(), stamp.end(), 0); queryStamp = 1; }
+
+    // local searches around both ends
+    int cs = clusterOf(sx, sy), ct = clusterOf(tx, ty);
+    int x0, y0, x1, y1;
+    ClusterBfs fromStart, fromTarget;
+    clusterRect(cs, x0, y0, x1, y1);
+    fromStart.run(maze, x0, y0, x1, y1, sx, sy);
+    clusterRect(ct, x0, y0, x1, y1);
+    fromTarget.run(maze, x0, y0, x1, y1, tx, ty);
+    for (int n = clusterStart[ct]; n < clusterStart[ct + 1]; n++) goalCost[n] = fromTarget.at(nodeX[n], nodeY[n]);
+
+    int best = INT_MAX, meet = -1;
+    if (cs == ct && fromStart.at(tx, ty) >= 0) best = fromStart.at(tx, ty);
+
+    auto heuristic = [&](int n) { return abs(nodeX[n] - tx) + abs(nodeY[n] - ty); };
+    auto later = [](const OpenNode& a, const OpenNode& b) { return a.key > b.key; };
+    open.clear();
+    for (int n = clusterStart[cs]; n < clusterStart[cs + 1]; n++) {
+        int d = fromStart.at(nodeX[n], nodeY[n]);
+        if (d < 0) continue;
+        stamp[n] = queryStamp; g[n] = d; parent[n] = -1;
+        open.push_back({ hpaKey(d + heuristic(n), d), n });
+        push_heap(open.begin(), open.end(), later);
+    }
+
+    while (!open.empty()) {
+        uint32_t f = (uint32_t)(open.front().key >> 32);
+        uint32_t gu = ~(uint32_t)open.front().key;
+        int u = open.front().node;
+        pop_heap(open.begin(), open.end(), later);
+        open.pop_back();
+        if ((int)gu != g[u]) continue;
+        if ((long long)f >= best) break; // nothing left can beat it
+        expandedCount++;
+
+        if (u >= clusterStart[ct] && u < clusterStart[ct + 1] && goalCost[u] >= 0 && g[u] + goalCost[u] < best) {
+            best = g[u] + goalCost[u];
+            meet = u;
+        }
+        for (int e = edgeStart[u]; e < edgeStart[u + 1]; e++) {
+            int v = edgeTo[e], ng = g[u] + edgeCost[e];
+            if (stamp[v] == queryStamp && g[v] <= ng) continue;
+            stamp[v] = queryStamp; g[v] = ng; parent[v] = u;
+            open.push_back({ hpaKey(ng + heuristic(v), ng), v });
+            push_heap(open.begin(), open.end(), later);
+        }
+    }
+    if (best == INT_MAX) return -1;
+    if (!path) return best;
+
+    // refine: local paths between consecutive entrances
+    path->clear();
+    if (meet < 0) { fromStart.pathTo(tx, ty, width, *path); return best; }
+
+    vector<int> chain;
+    for (int n = meet; n >= 0; n = parent[n]) chain.push_back(n);
+    reverse(chain.begin(), chain.end());
+    fromStart.pathTo(nodeX[chain[0]], nodeY[chain[0]], width, *path);
+    ClusterBfs leg;
+    for (size_t i = 1; i < chain.size(); i++) {
+        int a = chain[i - 1], b = chain[i];
+        int ca = clusterOf(nodeX[a], nodeY[a]);
+        if (ca != clusterOf(nodeX[b], nodeY[b])) { path->push_back(nodeY[b] * width + nodeX[b]); continue; }
+        clusterRect(ca, x0, y0, x1, y1);
+        leg.run(maze, x0, y0, x1, y1, nodeX[a], nodeY[a]);
+        path->pop_back(); // a is the first cell of the leg
+        leg.pathTo(nodeX[b], nodeY[b], width, *path);
+    }
+    // target side: BFS ran from the target, so walk it backwards
+    vector<int> tail;
+    fromTarget.pathTo(nodeX[meet], nodeY[meet], width, tail);
+    for (int i = (int)tail.size() - 2; i >= 0; i--) path->push_back(tail[i]);
+    return best;
+}
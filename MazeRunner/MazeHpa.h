@@ -0,0 +1,54 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "Maze.h"
+
+// -------------------- HIERARCHICAL SEARCH (HPA*) --------------------
+// The board is cut into square clusters. Every open cell pair straddling a
+// cluster border becomes two entrance nodes joined by a 1-step edge, and the
+// entrances of one cluster are joined by their shortest distance inside it.
+// A query searches inside the start and target clusters, then runs A* on
+// that small graph, then optionally refines the result into a cell path.
+// Corridors are one cell wide, so entrances are never merged and distances
+// stay exact.
+//
+// Built once per maze; the per-cluster searches run on a thread pool.
+// Only maze-cli bench uses it for now: there is no update path for shifting
+// walls, and game-size boards are answered fast enough by GridSearch.
+const int HPA_DEFAULT_CLUSTER = 128; // grid cells per cluster side
+
+class HpaGraph {
+public:
+    // threads 0 = one per core
+    void build(const Maze& maze, int clusterSize = HPA_DEFAULT_CLUSTER, int threads = 0);
+
+    // Steps between two cells, -1 if there is no path. path, when given,
+    // receives the grid indices from start to target. The maze must be the
+    // one the graph was built from.
+    int query(const Maze& maze, int sx, int sy, int tx, int ty, std::vector<int>* path = nullptr);
+
+    int nodeCount() const { return (int)nodeX.size(); }
+    long long edgeCount() const { return (long long)edgeTo.size(); }
+    long long expanded() const { return expandedCount; } // abstract nodes, last query
+    size_t memoryBytes() const;
+
+private:
+    int width = 0, height = 0;
+    int clusterSize = HPA_DEFAULT_CLUSTER, clustersX = 0, clustersY = 0;
+
+    // nodes, grouped by cluster: cluster c owns [clusterStart[c], clusterStart[c + 1])
+    std::vector<int> nodeX, nodeY, clusterStart;
+    // edges in CSR form: node n owns [edgeStart[n], edgeStart[n + 1])
+    std::vector<int> edgeStart, edgeTo, edgeCost;
+
+    // query scratch, reused (stamp == current query means valid)
+    std::vector<uint32_t> stamp;
+    std::vector<int> g, parent, goalCost;
+    uint32_t queryStamp = 0;
+    struct OpenNode { uint64_t key; int node; };
+    std::vector<OpenNode> open;
+    long long expandedCount = 0;
+
+    int clusterOf(int x, int y) const { return (y / clusterSize) * clustersX + x / clusterSize; }
+    void clusterRect(int c, int& x0, int& y0, int& x1, int& y1) const;
+};
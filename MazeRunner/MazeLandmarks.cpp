@@ -0,0 +1,216 @@
+#include "MazeLandmarks.h"
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <cstdlib>
+#include <thread>
+
+using namespace std;
+
+// up, down, left, right; d ^ 1 is the opposite direction
+static const int stepX[4] = { 0, 0, -1, 1 };
+static const int stepY[4] = { -1, 1, 0, 0 };
+
+static const uint16_t FAR_AWAY = 0xFFFF;
+
+// -------------------- BUILD --------------------
+// Evenly spaced along the border: landmarks "behind" the cells work best,
+// and the border is behind most of the board
+void LandmarkOracle::placeLandmarks(const Maze& maze, int count) {
+    marks.clear();
+    long long perimeter = 2LL * (width - 1) + 2LL * (height - 1);
+    for (int i = 0; i < count; i++) {
+        long long p = perimeter * i / count;
+        int x, y;
+        if (p < width - 1) { x = (int)p; y = 0; }
+        else if ((p -= width - 1) < height - 1) { x = width - 1; y = (int)p; }
+        else if ((p -= height - 1) < width - 1) { x = width - 1 - (int)p; y = height - 1; }
+        else { p -= width - 1; x = 0; y = height - 1 - (int)p; }
+
+        // nearest open cell, rings outward
+        x = min(max(x, 1), width - 2);
+        y = min(max(y, 1), height - 2);
+        bool found = false;
+        for (int r = 0; r < max(width, height) && !found; r++) {
+            for (int yy = y - r; yy <= y + r && !found; yy++) {
+                for (int xx = x - r; xx <= x + r; xx++) {
+                    if (abs(xx - x) != r && abs(yy - y) != r) continue;
+                    if (maze.isOpen(xx, yy)) { marks.push_back({ xx, yy }); found = true; break; }
+                }
+            }
+        }
+    }
+}
+
+void LandmarkOracle::build(const Maze& maze, int count, bool compactValues, int threads) {
+    width = maze.width;
+    height = maze.height;
+    compact = compactValues;
+    placeLandmarks(maze, max(count, 1));
+    int k = (int)marks.size();
+    size_t cells = (size_t)width * height;
+
+    // no shortest path is longer than the open cell count, which fixes the
+    // 16-bit scale before any BFS runs
+    step = 1;
+    if (compact) {
+        long long openCells = 0;
+        for (int y = 0; y < height; y++)
+            for (int x = 0; x < width; x++) openCells += maze.isOpen(x, y);
+        step = (int)(openCells / (FAR_AWAY - 1) + 1);
+        narrow.assign(cells * k, FAR_AWAY);
+        wide.clear();
+    } else {
+        wide.assign(cells * k, -1);
+        narrow.clear();
+    }
+
+    if (threads <= 0) threads = (int)thread::hardware_concurrency();
+    if (threads <= 0) threads = 1;
+    if (threads > k) threads = k;
+    atomic<int> nextMark(0);
+    auto worker = [&]() {
+        BitBfs bfs;
+        vector<int> dist;
+        for (int i = nextMark++; i < k; i = nextMark++) {
+            bfs.run(maze, marks[i].x, marks[i].y, &dist);
+            if (compact) {
+                for (size_t c = 0; c < cells; c++)
+                    if (dist[c] >= 0) narrow[c * k + i] = (uint16_t)(dist[c] / step);
+            } else {
+                for (size_t c = 0; c < cells; c++) wide[c * k + i] = dist[c];
+            }
+        }
+    };
+    vector<thread> pool;
+    for (int i = 1; i < threads; i++) pool.emplace_back(worker);
+    worker();
+    for (size_t i = 0; i < pool.size(); i++) pool[i].join();
+}
+
+size_t LandmarkOracle::memoryBytes() const {
+    return wide.capacity() * sizeof(int) + narrow.capacity() * sizeof(uint16_t) +
+        cost.capacity() * sizeof(uint32_t) + fromDir.capacity() + open.capacity() * sizeof(OpenNode);
+}
+
+// -------------------- BOUNDS --------------------
+// Best lower bound between grid cells a and b, INT_MAX when some landmark
+// reaches only one of them
+int LandmarkOracle::lowerBound(int a, int b) const {
+    int k = (int)marks.size(), best = 0;
+    if (compact) {
+        const uint16_t* da = &narrow[(size_t)a * k];
+        const uint16_t* db = &narrow[(size_t)b * k];
+        for (int i = 0; i < k; i++) {
+            if ((da[i] == FAR_AWAY) != (db[i] == FAR_AWAY)) return INT_MAX;
+            best = max(best, abs((int)da[i] - (int)db[i]));
+        }
+        // each side is rounded down by up to step - 1
+        return max(best * step - (step - 1), 0);
+    }
+    const int* da = &wide[(size_t)a * k];
+    const int* db = &wide[(size_t)b * k];
+    for (int i = 0; i < k; i++) {
+        if ((da[i] < 0) != (db[i] < 0)) return INT_MAX;
+        best = max(best, abs(da[i] - db[i]));
+    }
+    return best;
+}
+
+bool LandmarkOracle::bounds(int sx, int sy, int tx, int ty, int& lower, int& upper) const {
+    lower = upper = -1;
+    if (marks.empty() || sx < 0 || sy < 0 || sx >= width || sy >= height || tx < 0 || ty < 0 || tx >= width || ty >= height)
+        return false;
+    int a = sy * width + sx, b = ty * width + tx;
+    int low = lowerBound(a, b);
+    if (low == INT_MAX) return false;
+
+    int k = (int)marks.size();
+    long long high = LLONG_MAX;
+    for (int i = 0; i < k; i++) {
+        long long da, db;
+        if (compact) {
+            if (narrow[(size_t)a * k + i] == FAR_AWAY) continue;
+            da = (long long)narrow[(size_t)a * k + i] * step + step - 1;
+            db = (long long)narrow[(size_t)b * k + i] * step + step - 1;
+        } else {
+            if (wide[(size_t)a * k + i] < 0) continue;
+            da = wide[(size_t)a * k + i];
+            db = wide[(size_t)b * k + i];
+        }
+        high = min(high, da + db);
+    }
+    lower = low;
+    // reached by no landmark: a pocket cut off from all of them; only the
+    // lower bound is known (0 unless it is the same cell)
+    upper = high == LLONG_MAX ? INT_MAX : (int)high;
+    return true;
+}
+
+// -------------------- A* --------------------
+static uint64_t altKey(uint32_t f, uint32_t g) {
+    return ((uint64_t)f << 32) | (uint32_t)~g;
+}
+
+int LandmarkOracle::distance(const Maze& maze, int sx, int sy, int tx, int ty, vector<int>* path) {
+    expandedCount = 0;
+    if (!maze.isOpen(sx, sy) || !maze.isOpen(tx, ty) || maze.width != width || maze.height != height) return -1;
+    size_t cells = (size_t)width * height;
+    if (cost.size() < cells) {
+        cost.assign(cells, 0);
+        fromDir.resize(cells);
+        base = 1;
+    }
+    if (base == 0 || base > UINT32_MAX - (uint32_t)cells - 1) {
+        fill(cost.begin(), cost.end(), 0);
+        base = 1;
+    }
+    open.clear();
+
+    int start = sy * width + sx, target = ty * width + tx;
+    int h0 = lowerBound(start, target);
+    if (h0 == INT_MAX) return -1;
+    auto later = [](const OpenNode& a, const OpenNode& b) { return a.key > b.key; };
+
+    cost[start] = base;
+    open.push_back({ altKey(max(h0, abs(sx - tx) + abs(sy - ty)), 0), start });
+    uint32_t maxSteps = 0;
+    while (!open.empty()) {
+        uint32_t g = ~(uint32_t)open.front().key;
+        int c = open.front().cell;
+        pop_heap(open.begin(), open.end(), later);
+        open.pop_back();
+        if (g != cost[c] - base) continue;
+        expandedCount++;
+        if (c == target) break;
+
+        int x = c % width, y = c / width;
+        uint32_t ng = g + 1;
+        for (int k = 0; k < 4; k++) {
+            int nx = x + stepX[k], ny = y + stepY[k];
+            if (!maze.isOpen(nx, ny)) continue;
+            int n = ny * width + nx;
+            if (cost[n] >= base && cost[n] - base <= ng) continue;
+            cost[n] = base + ng;
+            fromDir[n] = (uint8_t)k;
+            int h = max(lowerBound(n, target), abs(nx - tx) + abs(ny - ty));
+            open.push_back({ altKey(ng + h, ng), n });
+            push_heap(open.begin(), open.end(), later);
+        }
+        if (ng > maxSteps) maxSteps = ng;
+    }
+
+    int result = cost[target] >= base ? (int)(cost[target] - base) : -1;
+    if (result >= 0 && path) {
+        path->assign(result + 1, 0);
+        int c = target;
+        for (int i = result; i >= 0; i--) {
+            (*path)[i] = c;
+            if (i == 0) break;
+            int d = fromDir[c];
+            c -= stepY[d] * width + stepX[d];
+        }
+    }
+    base += maxSteps + 1;
+    return result;
+}
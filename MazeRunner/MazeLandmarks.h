@@ -0,0 +1,56 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "Maze.h"
+#include "MazeBitBfs.h"
+
+// -------------------- LANDMARK (ALT) ORACLE --------------------
+// K landmark cells spread around the border, each with a full BFS distance
+// array. For any landmark L the triangle inequality gives
+//   |d(L, a) - d(L, b)| <= d(a, b) <= d(L, a) + d(L, b)
+// so a distance is bounded in O(K) lookups, and the best lower bound makes
+// a much sharper A* heuristic than the Manhattan distance.
+//
+// Memory is K values per grid cell, stored cell by cell so one query reads
+// one short run. Compact mode keeps 16 bits per value: exact up to 65534
+// open cells, past that the values are divided by scale() and the bounds
+// widen by up to scale() - 1 to stay correct.
+const int ALT_DEFAULT_LANDMARKS = 8;
+
+class LandmarkOracle {
+public:
+    // threads 0 = one per core; one BFS per landmark
+    void build(const Maze& maze, int count = ALT_DEFAULT_LANDMARKS, bool compact = false, int threads = 0);
+
+    // O(K) bounds on the steps between two open cells. Returns false when
+    // some landmark reaches one cell and not the other (no path).
+    bool bounds(int sx, int sy, int tx, int ty, int& lower, int& upper) const;
+
+    // Exact steps by A* with the landmark bound, -1 if there is no path.
+    // path, when given, receives the grid indices from start to target.
+    int distance(const Maze& maze, int sx, int sy, int tx, int ty, std::vector<int>* path = nullptr);
+
+    int landmarkCount() const { return (int)marks.size(); }
+    const GridPos& landmark(int i) const { return marks[i]; }
+    int scale() const { return step; }
+    long long expanded() const { return expandedCount; } // cells, last distance()
+    size_t memoryBytes() const;
+
+private:
+    int width = 0, height = 0, step = 1;
+    bool compact = false;
+    std::vector<GridPos> marks;
+    std::vector<int> wide;          // cell * K + landmark, -1 unreached
+    std::vector<uint16_t> narrow;   // same, compact: steps / step, 0xFFFF unreached
+
+    // A* scratch, same scheme as GridSearch
+    std::vector<uint32_t> cost;
+    std::vector<uint8_t> fromDir;
+    uint32_t base = 0;
+    struct OpenNode { uint64_t key; int cell; };
+    std::vector<OpenNode> open;
+    long long expandedCount = 0;
+
+    int lowerBound(int a, int b) const;
+    void placeLandmarks(const Maze& maze, int count);
+};
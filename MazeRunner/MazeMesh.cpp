@@ -0,0 +1,106 @@
+#include "MazeMesh.h"
+#include <algorithm>
+#include <cmath>
+
+using namespace std;
+
+void MazeMesh::writeCell(const Maze& maze, int x, int y, sf::Vertex* quad) const {
+    float left = (float)(x * cellSize), top = (float)(y * cellSize), side = (float)cellSize;
+    quad[0].position = sf::Vector2f(left, top);
+    quad[1].position = sf::Vector2f(left + side, top);
+    quad[2].position = sf::Vector2f(left + side, top + side);
+    quad[3].position = sf::Vector2f(left, top + side);
+    sf::Color color = maze.isWall(x, y) ? WALL_COLOR : OPEN_COLOR;
+    if (x == maze.goalX && y == maze.goalY) color = sf::Color::Yellow;
+    for (int k = 0; k < 4; k++) quad[k].color = color;
+}
+
+void MazeMesh::reset(const Maze& maze, int size) {
+    width = maze.width;
+    height = maze.height;
+    cellSize = size;
+    chunksX = (width + MESH_CHUNK - 1) / MESH_CHUNK;
+    chunksY = (height + MESH_CHUNK - 1) / MESH_CHUNK;
+    slotOf.assign((size_t)chunksX * chunksY, -1);
+    for (Chunk& chunk : pool) chunk.key = -1;
+}
+
+// Fills a free slot, or the one used longest ago (keep = slots that may
+// stay in use without evicting)
+int MazeMesh::buildChunk(const Maze& maze, int key, size_t keep) {
+    int slot = -1;
+    for (size_t i = 0; i < pool.size() && slot < 0; i++)
+        if (pool[i].key < 0) slot = (int)i;
+    if (slot < 0 && pool.size() < keep) { pool.emplace_back(); slot = (int)pool.size() - 1; }
+    if (slot < 0) {
+        slot = 0;
+        for (size_t i = 1; i < pool.size(); i++)
+            if (pool[i].lastUsed < pool[slot].lastUsed) slot = (int)i;
+        slotOf[pool[slot].key] = -1;
+    }
+
+    Chunk& chunk = pool[slot];
+    int x0 = key % chunksX * MESH_CHUNK, y0 = key / chunksX * MESH_CHUNK;
+    int cw = min(MESH_CHUNK, width - x0), ch = min(MESH_CHUNK, height - y0);
+    staging.resize((size_t)cw * ch * 4);
+    for (int y = 0; y < ch; y++)
+        for (int x = 0; x < cw; x++) writeCell(maze, x0 + x, y0 + y, &staging[((size_t)y * cw + x) * 4]);
+    chunk.inBuffer = sf::VertexBuffer::isAvailable() &&
+        (chunk.buffer.getVertexCount() == staging.size() || chunk.buffer.create(staging.size())) &&
+        chunk.buffer.update(staging.data());
+    if (!chunk.inBuffer) {
+        chunk.array.resize(staging.size());
+        for (size_t i = 0; i < staging.size(); i++) chunk.array[i] = staging[i];
+    }
+    chunk.key = key;
+    chunk.cellsWide = cw;
+    slotOf[key] = slot;
+    built++;
+    return slot;
+}
+
+void MazeMesh::updateCells(const Maze& maze, const vector<int>& cells) {
+    if (maze.width != width || maze.height != height) return; // a reset is on its way
+    sf::Vertex quad[4];
+    for (int c : cells) {
+        int x = c % width, y = c / width;
+        int slot = slotOf[(size_t)(y / MESH_CHUNK) * chunksX + x / MESH_CHUNK];
+        if (slot < 0) continue; // built with the new walls when it shows up
+        Chunk& chunk = pool[slot];
+        size_t at = ((size_t)(y % MESH_CHUNK) * chunk.cellsWide + x % MESH_CHUNK) * 4;
+        if (chunk.inBuffer) {
+            writeCell(maze, x, y, quad);
+            chunk.buffer.update(quad, 4, (unsigned)at);
+        }
+        else writeCell(maze, x, y, &chunk.array[at]);
+    }
+}
+
+void MazeMesh::draw(sf::RenderTarget& target, const Maze& maze) {
+    drawn = built = 0;
+    if (maze.width != width || maze.height != height || cellSize <= 0) return;
+    frame++;
+
+    // chunks under the view rectangle (no rotation)
+    const sf::View& view = target.getView();
+    float span = (float)(MESH_CHUNK * cellSize);
+    sf::Vector2f half = view.getSize() / 2.0f, center = view.getCenter();
+    int cx0 = max(0, (int)floor((center.x - half.x) / span)), cx1 = min(chunksX - 1, (int)floor((center.x + half.x) / span));
+    int cy0 = max(0, (int)floor((center.y - half.y) / span)), cy1 = min(chunksY - 1, (int)floor((center.y + half.y) / span));
+    if (cx0 > cx1 || cy0 > cy1) return;
+
+    // everything on screen stays, plus as many again for panning back
+    size_t keep = max((size_t)MESH_MIN_POOL, (size_t)(cx1 - cx0 + 1) * (cy1 - cy0 + 1) * 2);
+    for (int cy = cy0; cy <= cy1; cy++) {
+        for (int cx = cx0; cx <= cx1; cx++) {
+            int key = cy * chunksX + cx;
+            int slot = slotOf[key];
+            if (slot < 0) slot = buildChunk(maze, key, keep);
+            Chunk& chunk = pool[slot];
+            chunk.lastUsed = frame;
+            if (chunk.inBuffer) target.draw(chunk.buffer);
+            else target.draw(chunk.array);
+            drawn++;
+        }
+    }
+}
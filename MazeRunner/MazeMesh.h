@@ -0,0 +1,52 @@
+#pragma once
+#include <deque>
+#include <vector>
+#include <SFML/Graphics.hpp>
+#include "Maze.h"
+
+// -------------------- MAZE MESH --------------------
+// The board as one quad per cell, cut into MESH_CHUNK x MESH_CHUNK cell
+// chunks with a vertex buffer each (a vertex array without driver support).
+// Only chunks inside the target's current view are built and drawn, so a
+// frame costs what the view shows, not what the board holds. A chunk is
+// built the first time it comes into view and kept in a pool of recently
+// used ones; walls that move rewrite their own four vertices if their
+// chunk is built. Boards up to MESH_CHUNK cells a side are one draw call.
+const int MESH_CHUNK = 64;
+const sf::Color WALL_COLOR(40, 40, 60);
+const sf::Color OPEN_COLOR(120, 120, 160);
+const int MESH_MIN_POOL = 16;   // chunks kept at least, beyond what is on screen
+
+class MazeMesh {
+public:
+    // New maze or cell size: every chunk is dropped and built again on demand
+    void reset(const Maze& maze, int cellSize);
+    void updateCells(const Maze& maze, const std::vector<int>& cells); // grid indices
+
+    // Builds the missing chunks the target's view overlaps and draws them
+    void draw(sf::RenderTarget& target, const Maze& maze);
+
+    int chunksDrawn() const { return drawn; }   // last draw
+    int chunksBuilt() const { return built; }   // last draw
+    int chunksKept() const { return (int)pool.size(); }
+
+private:
+    struct Chunk {
+        int key = -1;                   // chunk index, -1 = free
+        unsigned lastUsed = 0;
+        int cellsWide = 0;              // MESH_CHUNK, less on the right edge
+        bool inBuffer = false;          // else in array
+        sf::VertexBuffer buffer{ sf::Quads, sf::VertexBuffer::Static };
+        sf::VertexArray array{ sf::Quads };
+    };
+    int width = 0, height = 0, cellSize = 0;
+    int chunksX = 0, chunksY = 0;
+    std::deque<Chunk> pool;             // deque: chunks never move once made
+    std::vector<int> slotOf;            // chunk index -> pool slot, -1 = not built
+    std::vector<sf::Vertex> staging;
+    unsigned frame = 0;
+    int drawn = 0, built = 0;
+
+    void writeCell(const Maze& maze, int x, int y, sf::Vertex* quad) const;
+    int buildChunk(const Maze& maze, int key, size_t keep);
+};
@@ -0,0 +1,113 @@
+#include "MazeParallel.h"
+#include "MazeGen.h"
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+// Depth-first backtracker restricted to cells [cx0, cx1) x [cy0, cy1)
+void carveTile(Maze& maze, int cx0, int cy0, int cx1, int cy1, Rng& rng, vector<int>& stack) {
+    static const int dx[4] = { 0, 0, -1, 1 };
+    static const int dy[4] = { -1, 1, 0, 0 };
+    int w = cx1 - cx0;
+
+    stack.clear();
+    int sx = cx0 + (int)rng.below(w), sy = cy0 + (int)rng.below(cy1 - cy0);
+    maze.setWall(2 * sx + 1, 2 * sy + 1, false);
+    stack.push_back((sy - cy0) * w + (sx - cx0));
+
+    while (!stack.empty()) {
+        int c = stack.back();
+        int cx = cx0 + c % w, cy = cy0 + c / w;
+
+        int dirs[4] = { 0,1,2,3 };
+        shuffleArray(dirs, 4, rng);
+
+        bool moved = false;
+        for (int i = 0; i < 4; i++) {
+            int nx = cx + dx[dirs[i]], ny = cy + dy[dirs[i]];
+            if (nx < cx0 || nx >= cx1 || ny < cy0 || ny >= cy1) continue;
+            if (!maze.isWall(2 * nx + 1, 2 * ny + 1)) continue; // already carved
+            carvePassage(maze, cx, cy, nx, ny);
+            stack.push_back((ny - cy0) * w + (nx - cx0));
+            moved = true;
+            break;
+        }
+        if (!moved) stack.pop_back();
+    }
+}
+
+void generateMazeTiled(Maze& maze, int threads, uint64_t seed) {
+    maze.fillAllWithWalls();
+    int cw = cellsWide(maze), ch = cellsHigh(maze);
+    int tilesX = (cw + TILE_CELLS - 1) / TILE_CELLS;
+    int tilesY = (ch + TILE_CELLS - 1) / TILE_CELLS;
+    int tiles = tilesX * tilesY;
+
+    if (threads <= 0) threads = (int)thread::hardware_concurrency();
+    if (threads <= 0) threads = 1;
+    if (threads > tiles) threads = tiles;
+
+    // workers grab tiles from a shared counter
+    atomic<int> nextTile(0);
+    auto worker = [&]() {
+        vector<int> stack;
+        stack.reserve(TILE_CELLS * TILE_CELLS);
+        for (int t = nextTile++; t < tiles; t = nextTile++) {
+            int tx = t % tilesX, ty = t / tilesX;
+            int cx0 = tx * TILE_CELLS, cy0 = ty * TILE_CELLS;
+            int cx1 = min(cx0 + TILE_CELLS, cw), cy1 = min(cy0 + TILE_CELLS, ch);
+            Rng rng(seed, (uint64_t)t + 1);
+            carveTile(maze, cx0, cy0, cx1, cy1, rng, stack);
+        }
+    };
+    vector<thread> pool;
+    for (int i = 1; i < threads; i++) pool.emplace_back(worker);
+    worker();
+    for (size_t i = 0; i < pool.size(); i++) pool[i].join();
+
+    // stitch: Kruskal over the tile graph, one passage per tree edge
+    Rng rng(seed, 0); // stream 0 is the stitcher, tiles use 1..tiles
+    vector<int> edges; // tile * 2 + 0 = east seam, + 1 = south seam
+    for (int t = 0; t < tiles; t++) {
+        if (t % tilesX + 1 < tilesX) edges.push_back(t * 2);
+        if (t / tilesX + 1 < tilesY) edges.push_back(t * 2 + 1);
+    }
+    for (int i = (int)edges.size() - 1; i > 0; i--) {
+        int j = (int)rng.below(i + 1);
+        int tmp = edges[i]; edges[i] = edges[j]; edges[j] = tmp;
+    }
+    vector<int> parent(tiles);
+    for (int t = 0; t < tiles; t++) parent[t] = t;
+
+    for (size_t i = 0; i < edges.size(); i++) {
+        int t = edges[i] / 2;
+        bool east = (edges[i] % 2 == 0);
+        int other = east ? t + 1 : t + tilesX;
+        int a = findSet(parent, t), b = findSet(parent, other);
+        if (a == b) continue;
+        parent[b] = a;
+
+        int tx = t % tilesX, ty = t / tilesX;
+        if (east) {
+            // random row along the seam between column tx and tx+1
+            int cy0 = ty * TILE_CELLS, cy1 = min(cy0 + TILE_CELLS, ch);
+            int cx = (tx + 1) * TILE_CELLS - 1;
+            int cy = cy0 + (int)rng.below(cy1 - cy0);
+            carvePassage(maze, cx, cy, cx + 1, cy);
+        }
+        else {
+            int cx0 = tx * TILE_CELLS, cx1 = min(cx0 + TILE_CELLS, cw);
+            int cy = (ty + 1) * TILE_CELLS - 1;
+            int cx = cx0 + (int)rng.below(cx1 - cx0);
+            carvePassage(maze, cx, cy, cx, cy + 1);
+        }
+    }
+
+    finishMaze(maze);
+}
+
+void generateMazeTiledDefault(Maze& maze, Rng& rng) {
+    generateMazeTiled(maze, 0, rng.next());
+}
@@ -0,0 +1,18 @@
+#pragma once
+#include <cstdint>
+#include "Maze.h"
+#include "Rng.h"
+
+// Tile edge in cells. 64 cells = 128 grid columns = two whole row words, so
+// threads working on side-by-side tiles never write the same word.
+const int TILE_CELLS = 64;
+
+// Splits the board into tiles, carves a perfect maze in each tile on a pool
+// of threads (0 = one per core), then opens exactly one passage per edge of
+// a random spanning tree over the tiles. The result is a perfect maze.
+// Each tile uses its own Rng stream Rng(seed, tile index), so the maze
+// depends on the seed only, not on the thread count.
+void generateMazeTiled(Maze& maze, int threads, uint64_t seed);
+
+// Table entry: all cores, seed drawn from rng
+void generateMazeTiledDefault(Maze& maze, Rng& rng);
@@ -0,0 +1,81 @@
+#include "MazePool.h"
+#include "MazeGen.h"
+
+using namespace std;
+
+void MazePool::start(int cap, uint64_t seed) {
+    stop();
+    maxReady = cap < 1 ? 1 : cap;
+    seeds.reseed(seed);
+    running = true;
+    worker = thread(&MazePool::run, this);
+}
+
+void MazePool::stop() {
+    {
+        lock_guard<mutex> guard(lock);
+        running = false;
+    }
+    wake.notify_all();
+    if (worker.joinable()) worker.join();
+}
+
+void MazePool::setWanted(int width, int height, int gen, const GenOptions& options) {
+    lock_guard<mutex> guard(lock);
+    width = clampMazeSize(width);
+    height = clampMazeSize(height);
+    if (width == wantW && height == wantH && gen == wantGen && options == wantOptions) return;
+    wantW = width; wantH = height; wantGen = gen; wantOptions = options;
+
+    // stale boards go back as spare storage
+    while (!ready.empty()) {
+        spares.push_back(std::move(ready.front()));
+        ready.pop_front();
+    }
+    wake.notify_all();
+}
+
+bool MazePool::take(Maze& out, DistanceField& toGoal) {
+    lock_guard<mutex> guard(lock);
+    // a board of another size (e.g. from a loaded save) is never swapped in
+    if (ready.empty() || out.width != wantW || out.height != wantH) { missCount++; wake.notify_all(); return false; }
+
+    std::swap(out, ready.front().maze);
+    std::swap(toGoal, ready.front().toGoal);
+    spares.push_back(std::move(ready.front()));
+    ready.pop_front();
+    hitCount++;
+    wake.notify_all();
+    return true;
+}
+
+int MazePool::readyCount() {
+    lock_guard<mutex> guard(lock);
+    return (int)ready.size();
+}
+
+void MazePool::run() {
+    PooledMaze next;
+    unique_lock<mutex> guard(lock);
+    while (true) {
+        wake.wait(guard, [&] { return !running || (int)ready.size() < maxReady; });
+        if (!running) return;
+
+        int w = wantW, h = wantH, gen = wantGen;
+        GenOptions options = wantOptions;
+        uint64_t seed = seeds.next();
+        if (!spares.empty()) { next = std::move(spares.back()); spares.pop_back(); }
+
+        // generate without holding the lock
+        guard.unlock();
+        next.maze.resize(w, h);
+        generateMaze(next.maze, gen, seed, options);
+        next.toGoal.buildToGoal(next.maze);
+        guard.lock();
+
+        // the wanted board may have changed meanwhile
+        if (w == wantW && h == wantH && gen == wantGen && options == wantOptions) ready.push_back(std::move(next));
+        else spares.push_back(std::move(next));
+        next = PooledMaze();
+    }
+}
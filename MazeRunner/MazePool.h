@@ -0,0 +1,58 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "Maze.h"
+#include "MazeSolve.h"
+#include "Rng.h"
+
+// Keeps the next few mazes ready on a worker thread so New Game / restart
+// never generate on the render thread. Only mazes matching the wanted size
+// generator and options are handed out; changing any drops the stale ones.
+// The goal distance field is built on the worker too.
+struct PooledMaze {
+    Maze maze;
+    DistanceField toGoal;
+};
+
+class MazePool {
+public:
+    MazePool() {}
+    ~MazePool() { stop(); }
+
+    void start(int capacity, uint64_t seed);
+    void stop();
+
+    // What to keep ready from now on
+    void setWanted(int width, int height, int gen, const GenOptions& options);
+
+    // Swaps a ready maze of out's size (and its field) into out (O(1), no
+    // copy) and hands the old storage back to the worker for reuse.
+    // false on a miss: the caller generates.
+    bool take(Maze& out, DistanceField& toGoal);
+
+    long long hits() const { return hitCount; }
+    long long misses() const { return missCount; }
+    int readyCount();
+    int capacity() const { return maxReady; }
+
+private:
+    int maxReady = 0;
+    int wantW = DEFAULT_MAZE_W, wantH = DEFAULT_MAZE_H, wantGen = 0;
+    GenOptions wantOptions;
+    Rng seeds;
+    std::deque<PooledMaze> ready;
+    std::vector<PooledMaze> spares; // storage to generate into
+    std::atomic<long long> hitCount{ 0 }, missCount{ 0 };
+
+    bool running = false;
+    std::thread worker;
+    std::mutex lock;
+    std::condition_variable wake;
+
+    void run();
+};
@@ -0,0 +1,122 @@
+#include "MazeRepair.h"
+#include <algorithm>
+
+using namespace std;
+
+size_t FieldRepair::memoryBytes() const {
+    return lost.capacity() + (dropped.capacity() + queue.capacity()) * sizeof(int) + (seeds.capacity() + undo.capacity()) * sizeof(Seed);
+}
+
+long long FieldRepair::apply(const Maze& maze, DistanceField& field, const vector<int>& changed, long long limit) {
+    int w = maze.width;
+    size_t cells = (size_t)w * maze.height;
+    // a new board, or the target itself changed: nothing to repair from
+    bool targetChanged = !maze.isOpen(field.targetX, field.targetY);
+    for (int c : changed) targetChanged = targetChanged || c == field.targetY * w + field.targetX;
+    bool resized = field.width != maze.width || field.height != maze.height || field.dist.size() != cells;
+    if (resized || targetChanged) {
+        if (limit >= 0) return -1;
+        if (!resized && !maze.isOpen(field.targetX, field.targetY)) fill(field.dist.begin(), field.dist.end(), -1);
+        else field.build(maze, field.targetX, field.targetY);
+        return (long long)cells;
+    }
+
+    vector<int>& dist = field.dist;
+    reserve(cells);
+    dropped.clear();
+    queue.clear();
+    auto isOpen = [&](int c) { return maze.isOpen(c % w, c / w); };
+    // neighbour k of cell c (up, down, left, right), -1 off the grid
+    auto neighbour = [&](int c, int k) {
+        int x = c % w;
+        if ((k == 2 && x == 0) || (k == 3 && x == w - 1)) return -1;
+        int n = c + (k == 0 ? -w : k == 1 ? w : k == 2 ? -1 : 1);
+        return (unsigned)n < cells ? n : -1;
+    };
+
+    // past this many touched cells a fresh BFS is cheaper than going on
+    long long budget = limit >= 0 ? limit : (long long)(cells / REPAIR_REBUILD_DIVISOR);
+    undo.clear();
+    auto set = [&](int c, int value) {
+        if (limit >= 0) undo.push_back({ dist[c], c });
+        dist[c] = value;
+    };
+    auto rebuild = [&]() {
+        for (int c : dropped) lost[c] = 0;
+        if (limit >= 0) {
+            for (size_t i = undo.size(); i-- > 0;) dist[undo[i].cell] = undo[i].dist;
+            return -1LL;
+        }
+        field.build(maze, field.targetX, field.targetY);
+        return (long long)cells;
+    };
+
+    // 1. closed cells, then every cell left with no valid way one step closer.
+    // queue keeps (cell, old value) pairs so children can still be found
+    for (int c : changed) {
+        if (isOpen(c) || dist[c] < 0 || lost[c]) continue;
+        lost[c] = 1;
+        dropped.push_back(c);
+        queue.push_back(c);
+        queue.push_back(dist[c]);
+    }
+    for (size_t head = 0; head < queue.size(); head += 2) {
+        int c = queue[head], d = queue[head + 1];
+        for (int k = 0; k < 4; k++) {
+            int n = neighbour(c, k);
+            if (n < 0 || lost[n] || dist[n] != d + 1) continue;
+            bool supported = false;
+            for (int j = 0; j < 4 && !supported; j++) {
+                int m = neighbour(n, j);
+                supported = m >= 0 && !lost[m] && dist[m] == d && isOpen(m);
+            }
+            if (supported) continue;
+            lost[n] = 1;
+            dropped.push_back(n);
+            queue.push_back(n);
+            queue.push_back(d + 1);
+        }
+        if ((long long)dropped.size() > budget) return rebuild();
+    }
+    for (int c : dropped) { set(c, -1); lost[c] = 0; }
+
+    // 2. seed dropped and newly opened cells from valid neighbours, sorted;
+    // the wave then merges them with a FIFO of its own (values only grow)
+    seeds.clear();
+    auto seed = [&](int c) {
+        if (!isOpen(c)) return;
+        int best = -1;
+        for (int k = 0; k < 4; k++) {
+            int n = neighbour(c, k);
+            if (n < 0 || dist[n] < 0 || !isOpen(n)) continue;
+            if (best < 0 || dist[n] + 1 < best) best = dist[n] + 1;
+        }
+        if (best < 0 || (dist[c] >= 0 && dist[c] <= best)) return;
+        set(c, best);
+        seeds.push_back({ best, c });
+    };
+    for (int c : dropped) seed(c);
+    for (int c : changed) seed(c);
+    sort(seeds.begin(), seeds.end(), [](const Seed& a, const Seed& b) { return a.dist < b.dist; });
+
+    long long touched = (long long)dropped.size();
+    queue.clear();
+    size_t head = 0, next = 0;
+    while (true) {
+        while (next < seeds.size() && dist[seeds[next].cell] != seeds[next].dist) next++; // lowered since
+        int c;
+        if (head < queue.size() && (next == seeds.size() || dist[queue[head]] <= seeds[next].dist)) c = queue[head++];
+        else if (next < seeds.size()) c = seeds[next++].cell;
+        else break;
+        if (++touched > budget) return rebuild();
+        int d = dist[c] + 1;
+        for (int k = 0; k < 4; k++) {
+            int n = neighbour(c, k);
+            if (n < 0 || !isOpen(n)) continue;
+            if (dist[n] >= 0 && dist[n] <= d) continue;
+            set(n, d);
+            queue.push_back(n);
+        }
+    }
+    return touched;
+}
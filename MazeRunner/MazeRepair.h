@@ -0,0 +1,48 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "Maze.h"
+#include "MazeSolve.h"
+
+// -------------------- INCREMENTAL FIELD REPAIR --------------------
+// Keeps a DistanceField right after walls open or close mid-match, the
+// unit-cost grid case of LPA* / D* Lite: only cells whose distance really
+// changes are touched.
+//
+// 1. Closed cells drop out. A cell whose every neighbour one step closer
+//    to the target has dropped out loses its value too, and so on outward.
+// 2. Those cells, plus the newly opened ones, are seeded from their still
+//    valid neighbours and settled smallest value first; the same wave
+//    lowers any cell a new opening brings closer.
+//
+// A batch that touches more than 1/REPAIR_REBUILD_DIVISOR of the board
+// (cutting a perfect maze near its root, say) stops and rebuilds instead,
+// so a repair never costs much more than a rebuild.
+//
+// One FieldRepair is meant to be kept and reused; its scratch grows to the
+// biggest board seen and is cleaned up cell by cell, never swept.
+const int REPAIR_REBUILD_DIVISOR = 8;
+
+class FieldRepair {
+public:
+    // The maze already has the edits; changed lists the grid indices
+    // (y * width + x) whose wall bit flipped, in any order, repeats allowed.
+    // Returns the cells dropped plus the cells settled by the wave.
+    // limit >= 0: a repair that would touch more cells than that is undone
+    // instead of falling back to a rebuild; -1 comes back and the field is as
+    // it was (putting the walls back is up to the caller).
+    long long apply(const Maze& maze, DistanceField& field, const std::vector<int>& changed, long long limit = -1);
+
+    // Sizes the scratch up front so the first repair on a big board does
+    // not pay for it
+    void reserve(size_t cells) { if (lost.size() < cells) lost.assign(cells, 0); }
+
+    size_t memoryBytes() const;
+
+private:
+    std::vector<uint8_t> lost;      // 1 while a cell is in the dropped set
+    std::vector<int> dropped, queue;
+    struct Seed { int dist, cell; };
+    std::vector<Seed> seeds;
+    std::vector<Seed> undo;         // old values, only kept under a limit
+};
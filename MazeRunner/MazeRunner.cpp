@@ -4,19 +4,44 @@
 #include <iostream>
 #include <fstream>
 #include <cstdlib>
+#include <cmath>
 #include <ctime>
 #include <string>
+#include <sstream>
 #include <filesystem>
+#include <charconv>
+#if defined(_MSC_VER) && defined(_DEBUG)
+#include <crtdbg.h>
+#define MAZE_COUNT_ALLOCATIONS
+#endif
+#include "Maze.h"
+#include "MazeGen.h"
+#include "MazeBot.h"
+#include "MazeSwarm.h"
+#include "MazeShift.h"
+#include "MazeMesh.h"
+#include "MazeShader.h"
+#include "MazePool.h"
+#include "MazeSolve.h"
+#include "MazeSearch.h"
+#include "MazeLandmarks.h"
+#include "Rng.h"
 
 using namespace std;
 
-// 
-const int CELL_SIZE = 24;
-const int MAZE_W = 31;
-const int MAZE_H = 31;
+// Layout: cell size and window size follow the board chosen at runtime.
+// A board that would need cells under MIN_CELL_SIZE gets a camera instead.
+const int CELL_SIZE = 24;      // preferred cell size in pixels
+const int MIN_CELL_SIZE = 6;
+const int CAMERA_CELL_SIZE = 12;
+const int MIN_WINDOW_W = 744;  // menu text needs about this much room
 const int HUD_HEIGHT = 70;
-const int WINDOW_W = MAZE_W * CELL_SIZE;
-const int WINDOW_H = MAZE_H * CELL_SIZE + HUD_HEIGHT;
+int cellSize = CELL_SIZE;
+int windowW = DEFAULT_MAZE_W * CELL_SIZE;
+int windowH = DEFAULT_MAZE_H * CELL_SIZE + HUD_HEIGHT;
+int boardAreaH = DEFAULT_MAZE_H * CELL_SIZE; // window pixels above the HUD
+bool cameraMode = false;
+bool cameraSnap = true;   // next frame jumps straight to the players (new board, layout)
 
 // Files
 const string SAVE_FILE = "savegame.txt";
@@ -24,13 +49,144 @@ const string SAVE_TMP = "savegame.tmp";
 const string WINS_FILE = "winhistory.txt";
 const string WINS_COUNT_FILE = "wins_count.txt";
 const int MAX_WINS_TO_STORE = 3; // stores last 3 wins in history
+const string SAVE_TAG = "MAZE"; // first token of saves that carry their own size
+
+// The board (size comes from --size, or from a loaded save)
+Maze maze;
+int mazeGenerator = GEN_STACK;
+GenOptions mazeOptions;  // --gt-policy / --gt-newest
+
+// Steps to the goal from every cell, rebuilt whenever the board changes;
+// drives the HUD step counters and the H hint
+DistanceField goalField;
+bool showHints = false;
+
+// Every maze gets its own 64-bit seed, shown in the HUD and saved.
+// --seed pins it so a match can be replayed.
+Rng seedSource(0);
+bool seedPinned = false;
+uint64_t pinnedSeed = 0;
+
+// Next few boards are generated ahead of time on a worker thread (--pool K,
+// 0 turns it off). A pinned seed always generates in place.
+MazePool mazePool;
+int poolSize = 3;
+// the board newMaze() dealt has not been raced on yet: New Game and the race
+// start keep it instead of taking a second one
+bool mazeUnplayed = false;
+
+// Player 2 can be a bot instead of the arrow keys (--bot <level>, B in the
+// menu cycles Human and the levels). It moves from the frame loop and reads
+// goalField, so a tick costs the same on any board size.
+int botLevel = -1; // -1 = human
+MazeBot bot;
+
+// Chaser swarm (--swarm N, E in the menu cycles the sizes, 0 = off). Every
+// enemy walks down the flow field of the nearer player; a caught player
+// goes back to the start and is left alone for SWARM_GRACE_TICKS.
+const int SWARM_SIZES[] = { 0, 100, 1000, 10000 };
+const int SWARM_SIZE_COUNT = 4;
+const int SWARM_GRACE_TICKS = 120;
+int swarmSize = 0;
+Swarm swarm;
+FlowField playerField[2];
+FlowField startField; // copied in on every respawn instead of a new BFS
+int swarmGrace[2] = { 0, 0 };
+sf::VertexArray enemyQuads(sf::Quads);
+
+// Shifting walls (--shift, S in the menu): one tile of the board gets new
+// walls every SHIFT_INTERVAL_TICKS while racing. Paths stay connected, the
+// cells under the players stay open, and goalField and the chasers' fields
+// are repaired in place instead of rebuilt.
+bool shiftingWalls = false;
+WallShifter shifter;
+
+// Steps between the two players for the HUD. Searched again only after one
+// of them moved or the board changed (boardEdits counts new boards and shifts).
+// A fresh board is answered by a landmark oracle, built on the first gap
+// asked for; after a shift it is out of date and GridSearch takes over.
+const long long GAP_ORACLE_MAX_CELLS = 1 << 22; // 8 landmarks, 2 bytes each
+GridSearch gapSearch;
+LandmarkOracle gapOracle;
+bool gapOracleStale = true;   // new board, build before the next gap
+long long gapOracleBoard = -1; // boardEdits when it was built
+long long boardEdits = 0;
+long long gapBoard = -1;
+int gapFrom[4] = { -1, -1, -1, -1 };
+int gapSteps = -1;
+
+// The board's quads, one draw call per frame. Rebuilt on the next draw after
+// a new maze, a load or a layout change (the shader board too); shifting
+// walls patch it in place.
+MazeMesh mazeMesh;
+bool mazeMeshStale = true;
+
+// --render shader: the board as a wall texture and one shaded quad instead.
+// Falls back to the mesh if the shader or the texture can't be made.
+const int RENDER_MESH = 0;
+const int RENDER_SHADER = 1;
+int renderBackend = RENDER_MESH;
+ShaderBoard shaderBoard;
+
+// Frame timing (--frametime): the work of a frame up to display(), without
+// the 60 FPS limiter's sleep, printed every few seconds
+bool reportFrameTime = false;
+sf::Clock frameClock;          // restarted at the top of every frame
+sf::Clock frameReportClock;
+double frameMsTotal = 0, frameMsWorst = 0;
+int framesTimed = 0;
+
+// Render on demand: a frame is drawn only when something on screen changed
+// (input, a mode change, the bot, chasers, shifting walls, the camera
+// easing); the game still ticks TICKS_PER_SECOND times a second. Screens
+// where nothing moves by itself (menu, name entry, paused, finished) block
+// in waitEvent once the autosave has caught up and the pool has filled.
+// --frametime also reports the time from waking up to the frame on screen.
+const int TICKS_PER_SECOND = 60;
+bool redraw = true;
+bool unsaved = false;           // a game screen changed since the last autosave
+int menuPoolShown = -1;         // ready boards on the menu as last drawn
+bool wokeUp = false;            // this frame follows a waitEvent
+sf::Clock wakeClock;
+double wakeMsTotal = 0, wakeMsWorst = 0;
+int wakeUps = 0;
+
+// Heap allocations on the main thread while drawing, for --frametime.
+// Only Debug builds count them, in the debug CRT's allocation hook: the
+// debug SFML DLLs share that CRT, so allocations inside sf::Text or
+// RenderTarget::draw are seen too. Other threads (maze pool, audio) are
+// left out. Release builds count nothing and the report says so.
+unsigned long long allocations = 0;
+unsigned long long drawAllocStart = 0, drawAllocTotal = 0;
+int framesAllocating = 0;
+
+#ifdef MAZE_COUNT_ALLOCATIONS
+thread_local bool countsAllocations = false;
+
+int __CRTDECL countAllocation(int type, void*, size_t, int, long, const unsigned char*, int) {
+    if (countsAllocations && (type == _HOOK_ALLOC || type == _HOOK_REALLOC)) allocations++;
+    return 1; // let it through
+}
+#endif
 
-// Maze storage: only 2D arrays, simple loops
-int maze[MAZE_H][MAZE_W];
+// from the main thread, only with --frametime
+void startAllocationCount() {
+#ifdef MAZE_COUNT_ALLOCATIONS
+    countsAllocations = true;
+    _CrtSetAllocHook(countAllocation);
+#endif
+}
 
-// Movement offsets up, down, left, right
-int moveX[4] = { 0, 0, -2, 2 };
-int moveY[4] = { -2, 2, 0, 0 };
+void newMaze() {
+    mazeMeshStale = true;
+    cameraSnap = true;
+    boardEdits++;
+    gapOracleStale = true;
+    mazeUnplayed = true;
+    if (!seedPinned && poolSize > 0 && mazePool.take(maze, goalField)) return;
+    generateMaze(maze, mazeGenerator, seedPinned ? pinnedSeed : seedSource.next(), mazeOptions);
+    goalField.buildToGoal(maze);
+}
 
 // game constants
 const int MODE_MENU = 10;
@@ -51,102 +207,146 @@ int player1X = 1, player1Y = 1;
 int player2X = 1, player2Y = 1;
 bool player1Reached = false, player2Reached = false;
 
-// Start and goal
-int startX = 1, startY = 1;
-int goalX = MAZE_W - 2, goalY = MAZE_H - 2;
-
 // Countdown counter 
 int countdownTicks = 120;
 
 // Win counters
 int player1Wins = 0, player2Wins = 0;
 
-// Menu background (optional)
-sf::Texture menuBackgroundTexture;
-sf::Sprite menuBackgroundSprite;
-
-// -------------------- MAZE HELPERS --------------------
-void fillAllWithWalls() {
-    for (int y = 0; y < MAZE_H; y++)
-        for (int x = 0; x < MAZE_W; x++)
-            maze[y][x] = 1; // 1 means wall
+// Enemies on random cells away from the start, fields on both players
+void spawnSwarm() {
+    swarm.clear();
+    if (swarmSize <= 0) return;
+    startField.reset(maze, maze.startX, maze.startY);
+    playerField[0].reset(maze, player1X, player1Y);
+    playerField[1].reset(maze, player2X, player2Y);
+    swarm.spawn(maze, startField, swarmSize, 20, maze.seed);
+    swarmGrace[0] = swarmGrace[1] = 0;
 }
 
-bool insideBounds(int x, int y) {
-    return x > 0 && x < MAZE_W - 1 && y > 0 && y < MAZE_H - 1;
+// After every single step (key repeat can bring two in one tick): the field
+// only follows one-cell moves incrementally, anything longer is a new BFS
+void followPlayer(int p) {
+    if (swarm.size() == 0) return;
+    if (p == 0) playerField[0].moveTarget(maze, player1X, player1Y);
+    else playerField[1].moveTarget(maze, player2X, player2Y);
 }
 
-void shuffleArray(int arr[], int n) {
-    for (int i = n - 1; i > 0; i--) {
-        int j = rand() % (i + 1);
-        int tmp = arr[i]; arr[i] = arr[j]; arr[j] = tmp;
+int playerGap() {
+    int from[4] = { player1X, player1Y, player2X, player2Y };
+    if (gapBoard == boardEdits && equal(from, from + 4, gapFrom)) return gapSteps;
+    copy(from, from + 4, gapFrom);
+    gapBoard = boardEdits;
+    if (gapOracleStale && (long long)maze.width * maze.height <= GAP_ORACLE_MAX_CELLS) {
+        gapOracle.build(maze, ALT_DEFAULT_LANDMARKS, true);
+        gapOracleBoard = boardEdits;
     }
+    gapOracleStale = false;
+    int lower, upper;
+    if (gapOracleBoard != boardEdits) {
+        // jump point search: corridors cost one step per junction, not per cell
+        gapSteps = gapSearch.jps(maze, player1X, player1Y, player2X, player2Y);
+    } else if (!gapOracle.bounds(player1X, player1Y, player2X, player2Y, lower, upper)) {
+        gapSteps = -1;
+    } else {
+        gapSteps = lower == upper ? lower : gapOracle.distance(maze, player1X, player1Y, player2X, player2Y);
+    }
+    return gapSteps;
 }
 
-void generateMazeSimple() {
-    fillAllWithWalls();
-
-    int x = startX;
-    int y = startY;
-    maze[y][x] = 0; // start position
-
-    bool madeProgress;
-    do {
-        madeProgress = false;
-        int dirs[4] = { 0,1,2,3 };
-        shuffleArray(dirs, 4);
-
-        for (int i = 0; i < 4; i++) {
-            int d = dirs[i];
-            int nx = x + moveX[d];
-            int ny = y + moveY[d];
-
-            if (insideBounds(nx, ny) && maze[ny][nx] == 1) {
-                // knock down wall
-                maze[y + moveY[d] / 2][x + moveX[d] / 2] = 0;
-                maze[ny][nx] = 0;
-
-                x = nx;
-                y = ny;
-                madeProgress = true;
-                break; // take one step at a time
-            }
-        }
-
-        //  scan for any unvisited neighbor and jump to continue
-        if (!madeProgress) {
-            for (int ty = 1; ty < MAZE_H - 1; ty += 2) {
-                for (int tx = 1; tx < MAZE_W - 1; tx += 2) {
-                    if (maze[ty][tx] == 0) {
-                        bool hasWallNeighbor = false;
-                        for (int d = 0; d < 4; d++) {
-                            int nx = tx + moveX[d];
-                            int ny = ty + moveY[d];
-                            if (insideBounds(nx, ny) && maze[ny][nx] == 1) {
-                                hasWallNeighbor = true;
-                                break;
-                            }
-                        }
-                        if (hasWallNeighbor) {
-                            x = tx; y = ty;
-                            madeProgress = true;
-                            break;
-                        }
-                    }
-                }
-                if (madeProgress) break;
-            }
-        }
+// Menu background (optional)
+sf::Texture menuBackgroundTexture;
+sf::Sprite menuBackgroundSprite;
 
-    } while (madeProgress);
+// center helpers for rendering (board pixels, boardView coordinates)
+float centerPixelX(int gridX) { return gridX * cellSize + cellSize / 2.0f; }
+float centerPixelY(int gridY) { return gridY * cellSize + cellSize / 2.0f; }
+
+// Picks a cell size so the board fits the desktop and the menu still has
+// room; past MIN_CELL_SIZE the window fills the desktop and the camera moves
+void computeLayout() {
+    sf::VideoMode desk = sf::VideoMode::getDesktopMode();
+    int areaW = (int)desk.width - 40, areaH = (int)desk.height - 120 - HUD_HEIGHT;
+    int fit = min(areaW / maze.width, areaH / maze.height);
+    int wanted = max(CELL_SIZE, MIN_WINDOW_W / maze.width);
+    cameraMode = fit < MIN_CELL_SIZE;
+    if (cameraMode) {
+        cellSize = CAMERA_CELL_SIZE;
+        windowW = max(MIN_WINDOW_W, areaW);
+        boardAreaH = max(CAMERA_CELL_SIZE, areaH);
+    }
+    else {
+        cellSize = min(wanted, fit);
+        windowW = maze.width * cellSize;
+        boardAreaH = maze.height * cellSize;
+    }
+    windowH = boardAreaH + HUD_HEIGHT;
+}
 
-    maze[startY][startX] = 0;
-    maze[goalY][goalX] = 0;
+// -------------------- CAMERA --------------------
+// boardView shows the board above the HUD, hudView the whole window in
+// pixels. A board that fits is shown whole. Otherwise the view frames the
+// players still racing with CAMERA_MARGIN cells around them, zooming out
+// up to CAMERA_MAX_ZOOM; past that it follows whoever is closer to the
+// goal. It eases towards that every frame and snaps after a new board.
+const int CAMERA_MARGIN = 6;
+const float CAMERA_MAX_ZOOM = 3.0f;
+const float CAMERA_EASE = 0.15f;   // share of the way covered per frame
+sf::View boardView, hudView;
+sf::Vector2f cameraCenter;
+float cameraZoom = 1.0f;
+bool cameraMoving = false;  // still easing after the last frame
+
+void updateCamera() {
+    float areaW = (float)windowW, areaH = (float)boardAreaH;
+    boardView.setViewport(sf::FloatRect(0, 0, 1, areaH / windowH));
+    if (!cameraMode) { boardView.reset(sf::FloatRect(0, 0, areaW, areaH)); cameraMoving = false; return; }
+
+    int xs[2] = { player1X, player2X }, ys[2] = { player1Y, player2Y };
+    bool racing[2] = { !player1Reached, !player2Reached };
+    if (!racing[0] && !racing[1]) racing[0] = racing[1] = true;
+    int minX = maze.width, minY = maze.height, maxX = 0, maxY = 0;
+    for (int p = 0; p < 2; p++) {
+        if (!racing[p]) continue;
+        minX = min(minX, xs[p]); maxX = max(maxX, xs[p]);
+        minY = min(minY, ys[p]); maxY = max(maxY, ys[p]);
+    }
+    float zoom = max(1.0f, max((maxX - minX + 1 + 2 * CAMERA_MARGIN) * cellSize / areaW, (maxY - minY + 1 + 2 * CAMERA_MARGIN) * cellSize / areaH));
+    sf::Vector2f target((minX + maxX + 1) * cellSize / 2.0f, (minY + maxY + 1) * cellSize / 2.0f);
+    if (zoom > CAMERA_MAX_ZOOM) {
+        int steps1 = goalField.at(player1X, player1Y), steps2 = goalField.at(player2X, player2Y);
+        int lead = (steps2 >= 0 && (steps1 < 0 || steps2 < steps1)) ? 1 : 0;
+        zoom = 1.0f;
+        target = sf::Vector2f(centerPixelX(xs[lead]), centerPixelY(ys[lead]));
+    }
+    // keep the view on the board (centred on an axis the board doesn't fill)
+    float boardW = (float)(maze.width * cellSize), boardH = (float)(maze.height * cellSize);
+    float halfW = areaW * zoom / 2, halfH = areaH * zoom / 2;
+    target.x = (2 * halfW >= boardW) ? boardW / 2 : max(halfW, min(boardW - halfW, target.x));
+    target.y = (2 * halfH >= boardH) ? boardH / 2 : max(halfH, min(boardH - halfH, target.y));
+
+    if (cameraSnap) { cameraCenter = target; cameraZoom = zoom; cameraSnap = false; }
+    else { cameraCenter += (target - cameraCenter) * CAMERA_EASE; cameraZoom += (zoom - cameraZoom) * CAMERA_EASE; }
+    // the last half pixel is a jump, so the camera comes to rest
+    sf::Vector2f left = target - cameraCenter;
+    cameraMoving = abs(left.x) > 0.5f || abs(left.y) > 0.5f || abs(zoom - cameraZoom) > 0.001f;
+    if (!cameraMoving) { cameraCenter = target; cameraZoom = zoom; }
+    boardView.setSize(areaW * cameraZoom, areaH * cameraZoom);
+    boardView.setCenter(cameraCenter);
 }
 
-// center helpers for rendering
-float centerPixelX(int gridX) { return gridX * CELL_SIZE + CELL_SIZE / 2.0f; }
-float centerPixelY(int gridY) { return gridY * CELL_SIZE + CELL_SIZE / 2.0f; }
+// Re-runs the layout and resizes the window (e.g. a save with another board size)
+void layoutWindow(sf::RenderWindow& window) {
+    computeLayout();
+    mazeMeshStale = true;
+    cameraSnap = true;
+    window.setSize(sf::Vector2u((unsigned)windowW, (unsigned)windowH));
+    hudView.reset(sf::FloatRect(0, 0, (float)windowW, (float)windowH));
+    window.setView(hudView);
+
+    sf::Vector2u s = menuBackgroundTexture.getSize();
+    if (s.x > 0) menuBackgroundSprite.setScale((float)windowW / s.x, (float)windowH / s.y);
+}
 
 // -------------------- FILE & SAVE HELPERS --------------------
 bool atomicWriteReplace(const string& filename, const string& tempname, const string& data) {
@@ -201,22 +401,20 @@ void loadWinsCount() {
 
 bool saveGameStateToFile() {
     string content;
+    content.reserve((size_t)(maze.width + 1) * maze.height + 256);
+    content += SAVE_TAG + " " + to_string(maze.width) + " " + to_string(maze.height) + " " + to_string(maze.seed) + " " + to_string(maze.generator) + " "
+        + to_string(maze.options.treePolicy) + " " + to_string(maze.options.treeNewestPercent) + "\n";
     content += to_string(gameMode) + "\n";
     content += player1Name + "\n" + player2Name + "\n";
     content += to_string(player1X) + " " + to_string(player1Y) + "\n";
     content += to_string(player2X) + " " + to_string(player2Y) + "\n";
     content += to_string(player1Reached) + " " + to_string(player2Reached) + "\n";
     content += to_string(countdownTicks) + "\n";
-    content += to_string(startX) + " " + to_string(startY) + "\n";
-    content += to_string(goalX) + " " + to_string(goalY) + "\n";
+    content += to_string(maze.startX) + " " + to_string(maze.startY) + "\n";
+    content += to_string(maze.goalX) + " " + to_string(maze.goalY) + "\n";
 
-    for (int y = 0; y < MAZE_H; y++) {
-        for (int x = 0; x < MAZE_W; x++) {
-            content += to_string(maze[y][x]);
-            if (x < MAZE_W - 1) content += " ";
-        }
-        content += "\n";
-    }
+    // one row per line, one char per cell
+    appendMazeRows(content, maze);
 
     return atomicWriteReplace(SAVE_FILE, SAVE_TMP, content);
 }
@@ -225,7 +423,28 @@ bool loadGameStateFromFile() {
     ifstream fin(SAVE_FILE);
     if (!fin) return false;
 
-    fin >> gameMode;
+    // old saves have no size header and are always 31x31 with spaced digits;
+    // the header is "MAZE w h [seed generator [treePolicy treeNewestPercent]]"
+    string first;
+    fin >> first;
+    bool legacy = (first != SAVE_TAG);
+    int w = DEFAULT_MAZE_W, h = DEFAULT_MAZE_H;
+    uint64_t seed = 0;
+    int gen = -1;
+    GenOptions options;
+    if (legacy) gameMode = atoi(first.c_str());
+    else {
+        string rest;
+        fin >> w >> h;
+        getline(fin, rest);
+        istringstream fields(rest);
+        int policy, percent;
+        fields >> seed >> gen;
+        if (fields >> policy >> percent && policy >= 0 && policy < GT_POLICY_COUNT) { options.treePolicy = policy; options.treeNewestPercent = percent; }
+        fin >> gameMode;
+    }
+    if (!fin || clampMazeSize(w) != w || clampMazeSize(h) != h) return false;
+
     fin.ignore(); 
     getline(fin, player1Name);
     getline(fin, player2Name);
@@ -234,11 +453,27 @@ bool loadGameStateFromFile() {
     fin >> d1 >> d2;
     player1Reached = (d1 != 0);
     player2Reached = (d2 != 0);
-    fin >> countdownTicks >> startX >> startY >> goalX >> goalY;
-
-    for (int y = 0; y < MAZE_H; y++)
-        for (int x = 0; x < MAZE_W; x++) fin >> maze[y][x];
+    int sx, sy, gx, gy;
+    fin >> countdownTicks >> sx >> sy >> gx >> gy;
+
+    if (sx < 0 || sx >= w || sy < 0 || sy >= h || gx < 0 || gx >= w || gy < 0 || gy >= h) return false;
+
+    maze.resize(w, h);
+    maze.startX = sx; maze.startY = sy; maze.goalX = gx; maze.goalY = gy;
+    maze.seed = seed; maze.generator = gen; maze.options = options;
+    mazeUnplayed = false;
+    boardEdits++;
+    gapOracleStale = true;
+    if (legacy) {
+        for (int y = 0; y < h; y++)
+            for (int x = 0; x < w; x++) { int v = 1; fin >> v; maze.setWall(x, y, v != 0); }
+    }
+    else if (!readMazeRows(fin, maze)) return false;
+    if (!fin) return false;
 
+    goalField.buildToGoal(maze);
+    mazeMeshStale = true;
+    cameraSnap = true;
     return true;
 }
 
@@ -254,104 +489,348 @@ bool saveFileExists() {
 void resetWinCounters() { player1Wins = 0; player2Wins = 0; saveWinsCount(); }
 
 // -------------------- DRAWING --------------------
-void drawMenuScreen(sf::RenderWindow& window, const sf::Font& font, bool hasSave) {
+// Menu and HUD text and shapes live across frames. A line is rebuilt into
+// hudLine (whose buffer is reused) and only handed to its sf::Text, which
+// then lays out the glyphs again, when it reads differently from last frame.
+struct HudText {
+    sf::Text text;
+    string shown;
+    void show(const string& s) { if (s != shown) { shown = s; text.setString(s); } }
+};
+HudText menuTitle, menuHint, menuOptions, menuPool, menuPlayers, menuNew, menuContinue;
+HudText hudSeed, hudSteps, hudInfo, hudCountdown, hudPaused, hudFinish;
+sf::RectangleShape menuOverlay, hudBar;
+sf::CircleShape playerDot[2], hintDot;
+string hudLine;
+
+// to_string would allocate for a seed (20 digits don't fit the small-string buffer)
+template <class T> void appendNumber(string& s, T n) {
+    char buf[24];
+    s.append(buf, to_chars(buf, buf + sizeof(buf), n).ptr);
+}
+
+void setupText(HudText& t, const sf::Font& font, unsigned size, const char* fixed = "") {
+    t.text.setFont(font);
+    t.text.setCharacterSize(size);
+    t.show(fixed);
+}
+
+// once the font is loaded
+void setupScreens(const sf::Font& font) {
+    setupText(menuTitle, font, 64, "MAZE RACE");
+    setupText(menuHint, font, 18, "Press N = New | C = Continue | R = Reset Wins | ESC = Exit");
+    setupText(menuOptions, font, 18);
+    setupText(menuPool, font, 14);
+    setupText(menuPlayers, font, 24);
+    setupText(menuNew, font, 36, "Start New Game (N)");
+    setupText(menuContinue, font, 36, "Continue Saved Game (C)");
+    setupText(hudSeed, font, 14);
+    setupText(hudSteps, font, 14);
+    setupText(hudInfo, font, 20);
+    setupText(hudCountdown, font, 40, "Get Ready...");
+    setupText(hudPaused, font, 40, "PAUSED\nPress P to resume");
+    setupText(hudFinish, font, 30);
+    menuOverlay.setFillColor(sf::Color(0, 0, 0, 120));
+    hudBar.setFillColor(sf::Color::Black);
+    playerDot[0].setFillColor(sf::Color::Blue);
+    playerDot[1].setFillColor(sf::Color::Red);
+}
+
+// shape geometry is rebuilt by setSize / setRadius, so only on a change
+void fitRect(sf::RectangleShape& r, float w, float h) {
+    if (r.getSize() != sf::Vector2f(w, h)) r.setSize(sf::Vector2f(w, h));
+}
+void fitCircle(sf::CircleShape& c, float radius) {
+    if (c.getRadius() != radius) { c.setRadius(radius); c.setOrigin(radius, radius); }
+}
+
+void drawCentered(sf::RenderWindow& window, HudText& t, float y) {
+    t.text.setPosition(windowW / 2 - t.text.getLocalBounds().width / 2, y);
+    window.draw(t.text);
+}
+
+// Every screen ends here instead of calling window.display() itself
+void presentFrame(sf::RenderWindow& window) {
+    if (reportFrameTime) {
+        double ms = frameClock.getElapsedTime().asMicroseconds() / 1000.0;
+        frameMsTotal += ms;
+        frameMsWorst = max(frameMsWorst, ms);
+        framesTimed++;
+        unsigned long long drawn = allocations - drawAllocStart;
+        drawAllocTotal += drawn;
+        if (drawn > 0) framesAllocating++;
+        if (frameReportClock.getElapsedTime().asSeconds() >= 5.0f) {
+            cout << "Frame time " << maze.width << "x" << maze.height << ": " << frameMsTotal / framesTimed << " ms mean, "
+                 << frameMsWorst << " ms worst over " << framesTimed << " frames" << endl;
+#ifdef MAZE_COUNT_ALLOCATIONS
+            cout << "Allocations while drawing: " << drawAllocTotal << ", in " << framesAllocating << " frames" << endl;
+#else
+            cout << "Allocations while drawing: not counted (Debug builds only)" << endl;
+#endif
+            if (wakeUps > 0) {
+                cout << "Wake-ups from idle: " << wakeUps << ", " << wakeMsTotal / wakeUps << " ms mean, " << wakeMsWorst
+                     << " ms worst to the frame on screen" << endl;
+                wakeMsTotal = wakeMsWorst = 0;
+                wakeUps = 0;
+            }
+            frameMsTotal = frameMsWorst = 0;
+            framesTimed = 0;
+            drawAllocTotal = 0;
+            framesAllocating = 0;
+            frameReportClock.restart();
+        }
+    }
+    window.display();
+    if (reportFrameTime && wokeUp) {
+        double ms = wakeClock.getElapsedTime().asMicroseconds() / 1000.0;
+        wakeMsTotal += ms;
+        wakeMsWorst = max(wakeMsWorst, ms);
+        wakeUps++;
+    }
+    wokeUp = false;
+}
+
+void drawMenuScreen(sf::RenderWindow& window, bool hasSave) {
+    drawAllocStart = allocations;
     window.clear();
+    window.setView(hudView);
     // Draw background sprite if loaded
     if (menuBackgroundTexture.getSize().x > 0) window.draw(menuBackgroundSprite);
 
-    sf::RectangleShape overlay(sf::Vector2f((float)WINDOW_W, (float)WINDOW_H));
-    overlay.setFillColor(sf::Color(0, 0, 0, 120));
-    window.draw(overlay);
-
-    sf::Text title("MAZE RACE", font, 64);
-    title.setPosition(WINDOW_W / 2 - title.getLocalBounds().width / 2, 80);
-    window.draw(title);
-
-    sf::Text hint("Press N = New | C = Continue | R = Reset Wins | ESC = Exit", font, 18);
-    hint.setPosition(WINDOW_W / 2 - hint.getLocalBounds().width / 2, 150);
-    window.draw(hint);
+    fitRect(menuOverlay, (float)windowW, (float)windowH);
+    window.draw(menuOverlay);
+
+    drawCentered(window, menuTitle, 80);
+    drawCentered(window, menuHint, 150);
+
+    hudLine = "Generator (G): "; hudLine += generatorName(mazeGenerator);
+    hudLine += "  |  Board: "; appendNumber(hudLine, maze.width); hudLine += "x"; appendNumber(hudLine, maze.height);
+    hudLine += "  |  Player 2 (B): ";
+    if (botLevel < 0) hudLine += "Human";
+    else { hudLine += "Bot "; hudLine += botLevelName(botLevel); }
+    hudLine += "  |  Chasers (E): ";
+    if (swarmSize > 0) appendNumber(hudLine, swarmSize);
+    else hudLine += "off";
+    hudLine += "  |  Walls (S): "; hudLine += shiftingWalls ? "shifting" : "still";
+    menuOptions.show(hudLine);
+    drawCentered(window, menuOptions, 175);
+
+    if (poolSize > 0 && !seedPinned) {
+        menuPoolShown = mazePool.readyCount();
+        hudLine = "Ready boards: "; appendNumber(hudLine, menuPoolShown); hudLine += "/"; appendNumber(hudLine, mazePool.capacity());
+        hudLine += "  (hits "; appendNumber(hudLine, mazePool.hits()); hudLine += ", misses "; appendNumber(hudLine, mazePool.misses()); hudLine += ")";
+        menuPool.show(hudLine);
+        drawCentered(window, menuPool, 198);
+    }
 
-    sf::Text playersTxt("", font, 24);
-    playersTxt.setPosition(40, 200);
-    string s = "Player1: " + player1Name + " (" + to_string(player1Wins) + ")\nPlayer2: " + player2Name + " (" + to_string(player2Wins) + ")";
-    playersTxt.setString(s);
-    window.draw(playersTxt);
+    hudLine = "Player1: "; hudLine += player1Name; hudLine += " ("; appendNumber(hudLine, player1Wins);
+    hudLine += ")\nPlayer2: "; hudLine += player2Name; hudLine += " ("; appendNumber(hudLine, player2Wins); hudLine += ")";
+    menuPlayers.show(hudLine);
+    menuPlayers.text.setPosition(40, 200);
+    window.draw(menuPlayers.text);
 
-    sf::Text btnNew("Start New Game (N)", font, 36);
-    btnNew.setPosition(WINDOW_W / 2 - btnNew.getLocalBounds().width / 2, 300);
-    window.draw(btnNew);
+    drawCentered(window, menuNew, 300);
 
-    sf::Text btnContinue("Continue Saved Game (C)", font, 36);
-    if (!hasSave) btnContinue.setFillColor(sf::Color(120, 120, 120));
-    btnContinue.setPosition(WINDOW_W / 2 - btnContinue.getLocalBounds().width / 2, 360);
-    window.draw(btnContinue);
+    menuContinue.text.setFillColor(hasSave ? sf::Color::White : sf::Color(120, 120, 120));
+    drawCentered(window, menuContinue, 360);
 
-    window.display();
+    presentFrame(window);
 }
 
-void drawGameScreen(sf::RenderWindow& window, const sf::Font& font) {
+void drawGameScreen(sf::RenderWindow& window) {
+    drawAllocStart = allocations;
     window.clear(sf::Color(10, 10, 30));
 
-    sf::RectangleShape cellShape(sf::Vector2f((float)CELL_SIZE, (float)CELL_SIZE));
-    for (int y = 0; y < MAZE_H; y++) {
-        for (int x = 0; x < MAZE_W; x++) {
-            if (maze[y][x] == 1) cellShape.setFillColor(sf::Color(40, 40, 60));
-            else cellShape.setFillColor(sf::Color(120, 120, 160));
-            cellShape.setPosition(x * CELL_SIZE, y * CELL_SIZE);
-            window.draw(cellShape);
+    // the board through the camera: walls, floor and goal are the chunks
+    // in view, enemies outside it are skipped
+    updateCamera();
+    window.setView(boardView);
+    if (mazeMeshStale) {
+        if (renderBackend == RENDER_SHADER && !shaderBoard.reset(maze, cellSize)) {
+            cout << "Warning: shader board not available, drawing the mesh." << endl;
+            renderBackend = RENDER_MESH;
+        }
+        if (renderBackend == RENDER_MESH) mazeMesh.reset(maze, cellSize);
+        mazeMeshStale = false;
+    }
+    if (renderBackend == RENDER_SHADER) shaderBoard.draw(window);
+    else mazeMesh.draw(window, maze);
+
+    sf::Vector2f viewHalf = boardView.getSize() / 2.0f;
+    int viewX0 = (int)((boardView.getCenter().x - viewHalf.x) / cellSize) - 1, viewX1 = (int)((boardView.getCenter().x + viewHalf.x) / cellSize) + 1;
+    int viewY0 = (int)((boardView.getCenter().y - viewHalf.y) / cellSize) - 1, viewY1 = (int)((boardView.getCenter().y + viewHalf.y) / cellSize) + 1;
+
+    if (swarm.size() > 0 && gameMode != MODE_ENTER_P1 && gameMode != MODE_ENTER_P2) {
+        // all enemies in view in one draw call
+        enemyQuads.resize((size_t)swarm.size() * 4);
+        size_t shown = 0;
+        float inset = cellSize * 0.2f, side = cellSize - 2 * inset;
+        for (int i = 0; i < swarm.size(); i++) {
+            int c = swarm.cellOf(i), cx = c % maze.width, cy = c / maze.width;
+            if (cx < viewX0 || cx > viewX1 || cy < viewY0 || cy > viewY1) continue;
+            float x = cx * cellSize + inset, y = cy * cellSize + inset;
+            sf::Vertex* q = &enemyQuads[shown++ * 4];
+            q[0].position = sf::Vector2f(x, y); q[1].position = sf::Vector2f(x + side, y);
+            q[2].position = sf::Vector2f(x + side, y + side); q[3].position = sf::Vector2f(x, y + side);
+            for (int k = 0; k < 4; k++) q[k].color = sf::Color(60, 200, 90);
         }
+        enemyQuads.resize(shown * 4);
+        window.draw(enemyQuads);
     }
 
-    sf::RectangleShape goalShape(sf::Vector2f((float)CELL_SIZE, (float)CELL_SIZE));
-    goalShape.setPosition(goalX * CELL_SIZE, goalY * CELL_SIZE);
-    goalShape.setFillColor(sf::Color::Yellow);
-    window.draw(goalShape);
+    fitCircle(playerDot[0], cellSize * 0.45f);
+    playerDot[0].setPosition(centerPixelX(player1X), centerPixelY(player1Y));
+    window.draw(playerDot[0]);
 
-    sf::CircleShape p1(CELL_SIZE * 0.45f); p1.setOrigin(p1.getRadius(), p1.getRadius());
-    p1.setPosition(centerPixelX(player1X), centerPixelY(player1Y)); p1.setFillColor(sf::Color::Blue);
-    window.draw(p1);
+    fitCircle(playerDot[1], cellSize * 0.45f);
+    playerDot[1].setPosition(centerPixelX(player2X), centerPixelY(player2Y));
+    window.draw(playerDot[1]);
 
-    sf::CircleShape p2(CELL_SIZE * 0.45f); p2.setOrigin(p2.getRadius(), p2.getRadius());
-    p2.setPosition(centerPixelX(player2X), centerPixelY(player2Y)); p2.setFillColor(sf::Color::Red);
-    window.draw(p2);
+    if (gameMode == MODE_PLAYING && showHints) {
+        // dot on the next cell of each player's shortest way to the goal
+        fitCircle(hintDot, cellSize * 0.15f);
+        int nx, ny;
+        if (!player1Reached && goalField.nextStep(player1X, player1Y, nx, ny) >= 0) {
+            hintDot.setPosition(centerPixelX(nx), centerPixelY(ny)); hintDot.setFillColor(sf::Color(120, 170, 255)); window.draw(hintDot);
+        }
+        if (!player2Reached && goalField.nextStep(player2X, player2Y, nx, ny) >= 0) {
+            hintDot.setPosition(centerPixelX(nx), centerPixelY(ny)); hintDot.setFillColor(sf::Color(255, 130, 130)); window.draw(hintDot);
+        }
+    }
 
-    sf::RectangleShape hud(sf::Vector2f((float)WINDOW_W, (float)HUD_HEIGHT)); hud.setPosition(0, MAZE_H * CELL_SIZE); hud.setFillColor(sf::Color::Black);
-    window.draw(hud);
+    // HUD and overlays in window pixels
+    window.setView(hudView);
+    fitRect(hudBar, (float)windowW, (float)HUD_HEIGHT); hudBar.setPosition(0, (float)boardAreaH);
+    window.draw(hudBar);
 
-    sf::Text info("", font, 20);
-    if (gameMode == MODE_ENTER_P1) {
-        info.setString("Enter Player 1: " + player1Name + "_"); info.setPosition(10, MAZE_H * CELL_SIZE + 20); window.draw(info); window.display(); return;
+    hudLine = "Seed: "; appendNumber(hudLine, maze.seed); hudLine += "  ("; hudLine += generatorName(maze.generator);
+    if (maze.generator == GEN_GROWING_TREE) {
+        hudLine += ", "; hudLine += GT_POLICY_IDS[maze.options.treePolicy];
+        if (maze.options.treePolicy == GT_MIXED) { hudLine += " "; appendNumber(hudLine, maze.options.treeNewestPercent); hudLine += "%"; }
     }
-    if (gameMode == MODE_ENTER_P2) {
-        info.setString("Enter Player 2: " + player2Name + "_"); info.setPosition(10, MAZE_H * CELL_SIZE + 20); window.draw(info); window.display(); return;
+    hudLine += ")";
+    hudSeed.show(hudLine);
+    hudSeed.text.setPosition(10, boardAreaH + 48);
+    window.draw(hudSeed.text);
+
+    if (gameMode == MODE_COUNTDOWN || gameMode == MODE_PLAYING || gameMode == MODE_PAUSED || gameMode == MODE_FINISHED) {
+        int steps1 = goalField.at(player1X, player1Y), steps2 = goalField.at(player2X, player2Y);
+        hudLine = "Steps to goal: "; hudLine += player1Name; hudLine += " ";
+        if (steps1 < 0) hudLine += "-"; else appendNumber(hudLine, steps1);
+        hudLine += "  |  "; hudLine += player2Name; hudLine += " ";
+        if (steps2 < 0) hudLine += "-"; else appendNumber(hudLine, steps2);
+        int gap = playerGap();
+        hudLine += "  |  Gap: ";
+        if (gap < 0) hudLine += "-"; else appendNumber(hudLine, gap);
+        hudSteps.show(hudLine);
+        hudSteps.text.setPosition(windowW - hudSteps.text.getLocalBounds().width - 10, boardAreaH + 48);
+        window.draw(hudSteps.text);
     }
-    if (gameMode == MODE_COUNTDOWN) {
-        info.setString("Get Ready..."); info.setCharacterSize(40); info.setPosition(WINDOW_W / 2 - 80, WINDOW_H / 2 - 40); window.draw(info); window.display(); return;
+
+    if (gameMode == MODE_ENTER_P1 || gameMode == MODE_ENTER_P2 || gameMode == MODE_PLAYING) {
+        if (gameMode == MODE_PLAYING) {
+            hudLine = player1Name; hudLine += " (WASD) vs "; hudLine += player2Name;
+            if (botLevel < 0) hudLine += " (ARROWS)";
+            hudLine += "  |  P = Pause  |  H = Hint";
+        }
+        else {
+            hudLine = gameMode == MODE_ENTER_P1 ? "Enter Player 1: " : "Enter Player 2: ";
+            hudLine += gameMode == MODE_ENTER_P1 ? player1Name : player2Name; hudLine += "_";
+        }
+        hudInfo.show(hudLine);
+        hudInfo.text.setPosition(10, boardAreaH + 20);
+        window.draw(hudInfo.text);
     }
-    if (gameMode == MODE_PLAYING) {
-        info.setString(player1Name + " (WASD) vs " + player2Name + " (ARROWS)  |  Press P to Pause"); info.setPosition(10, MAZE_H * CELL_SIZE + 20); window.draw(info); window.display(); return;
+    if (gameMode == MODE_COUNTDOWN) {
+        hudCountdown.text.setPosition(windowW / 2 - 80, windowH / 2 - 40); window.draw(hudCountdown.text);
     }
     if (gameMode == MODE_PAUSED) {
-        info.setString("PAUSED\nPress P to resume"); info.setCharacterSize(40); info.setPosition(WINDOW_W / 2 - 120, WINDOW_H / 2 - 40); window.draw(info); window.display(); return;
+        hudPaused.text.setPosition(windowW / 2 - 120, windowH / 2 - 40); window.draw(hudPaused.text);
     }
     if (gameMode == MODE_FINISHED) {
-        string winner;
-        if (player1Reached && player2Reached) winner = "It's a tie!";
-        else if (player1Reached) winner = player1Name + " WINS!";
-        else winner = player2Name + " WINS!";
-        info.setString(winner + "\nPress SPACE to restart"); info.setCharacterSize(30); info.setPosition(WINDOW_W / 2 - 150, WINDOW_H / 2 - 40);
-        window.draw(info); window.display(); return;
+        if (player1Reached && player2Reached) hudLine = "It's a tie!";
+        else { hudLine = player1Reached ? player1Name : player2Name; hudLine += " WINS!"; }
+        hudLine += "\nPress SPACE to restart";
+        hudFinish.show(hudLine);
+        hudFinish.text.setPosition(windowW / 2 - 150, windowH / 2 - 40); window.draw(hudFinish.text);
     }
 
-    window.display();
+    presentFrame(window);
 }
 
 // -------------------- MAIN --------------------
-int main() {
-    srand((unsigned int)time(nullptr));
+int main(int argc, char* argv[]) {
+    seedSource.reseed(randomSeed());
+
+    // Command line: --size N | --size WxH, --algo <id>, --seed <n>, --pool <k>, --bot <level>|human,
+    // --swarm <enemies>, --shift, --render mesh|shader, --frametime,
+    // --gt-policy newest|random|oldest|mixed, --gt-newest <percent>
+    // (benchmarks and bulk generation live in maze-cli)
+    int boardW = DEFAULT_MAZE_W, boardH = DEFAULT_MAZE_H;
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        if (arg == "--size" && i + 1 < argc) {
+            if (!parseMazeSize(argv[++i], boardW, boardH)) {
+                cout << "Warning: bad --size value, using default." << endl;
+                boardW = DEFAULT_MAZE_W; boardH = DEFAULT_MAZE_H;
+            }
+        }
+        else if (arg == "--algo" && i + 1 < argc) {
+            int gen = findGenerator(argv[++i]);
+            if (gen < 0) cout << "Warning: unknown --algo " << argv[i] << ", using " << generatorName(mazeGenerator) << endl;
+            else mazeGenerator = gen;
+        }
+        else if (arg == "--gt-policy" && i + 1 < argc) {
+            int policy = findGrowingTreePolicy(argv[++i]);
+            if (policy < 0) cout << "Warning: unknown --gt-policy " << argv[i] << ", using " << GT_POLICY_IDS[mazeOptions.treePolicy] << endl;
+            else mazeOptions.treePolicy = policy;
+        }
+        else if (arg == "--gt-newest" && i + 1 < argc) {
+            int percent = atoi(argv[++i]);
+            if (percent < 0 || percent > 100) cout << "Warning: --gt-newest wants 0..100, using " << mazeOptions.treeNewestPercent << endl;
+            else mazeOptions.treeNewestPercent = percent;
+        }
+        else if (arg == "--seed" && i + 1 < argc) {
+            pinnedSeed = strtoull(argv[++i], nullptr, 10);
+            seedPinned = true;
+        }
+        else if (arg == "--pool" && i + 1 < argc) {
+            poolSize = atoi(argv[++i]);
+            if (poolSize < 0) poolSize = 0;
+        }
+        else if (arg == "--bot" && i + 1 < argc) {
+            string id = argv[++i];
+            botLevel = findBotLevel(id);
+            if (botLevel < 0 && id != "human") cout << "Warning: unknown --bot " << id << ", player 2 is human" << endl;
+        }
+        else if (arg == "--swarm" && i + 1 < argc) {
+            swarmSize = atoi(argv[++i]);
+            if (swarmSize < 0) swarmSize = 0;
+        }
+        else if (arg == "--shift") shiftingWalls = true;
+        else if (arg == "--render" && i + 1 < argc) {
+            string id = argv[++i];
+            if (id == "shader") renderBackend = RENDER_SHADER;
+            else if (id == "mesh") renderBackend = RENDER_MESH;
+            else cout << "Warning: unknown --render " << id << ", drawing the mesh" << endl;
+        }
+        else if (arg == "--frametime") reportFrameTime = true;
+        else cout << "Warning: unknown argument " << arg << endl;
+    }
+    // the size the board really gets (odd, in range), so later size checks
+    // against boardW / boardH hold
+    boardW = clampMazeSize(boardW);
+    boardH = clampMazeSize(boardH);
+    if (reportFrameTime) startAllocationCount();
+    maze.resize(boardW, boardH);
+    computeLayout();
+    if (poolSize > 0 && !seedPinned) {
+        mazePool.setWanted(boardW, boardH, mazeGenerator, mazeOptions);
+        mazePool.start(poolSize, seedSource.next());
+    }
 
-    sf::RenderWindow window(sf::VideoMode(WINDOW_W, WINDOW_H), "Maze Race - Simple");
-    window.setFramerateLimit(60);
+    sf::RenderWindow window(sf::VideoMode(windowW, windowH), "Maze Race - Simple");
+    window.setFramerateLimit(TICKS_PER_SECOND);
 
     sf::Music backgroundMusic;
     if (!backgroundMusic.openFromFile("assets/sounds/background.mp3")) {
@@ -370,10 +849,8 @@ int main() {
     }
     else {
         menuBackgroundSprite.setTexture(menuBackgroundTexture);
-        sf::Vector2u s = menuBackgroundTexture.getSize();
-        float sx = (float)WINDOW_W / s.x; float sy = (float)WINDOW_H / s.y;
-        menuBackgroundSprite.setScale(sx, sy);
     }
+    layoutWindow(window);
 
     sf::Font font;
 #if defined(_WIN32)
@@ -390,29 +867,79 @@ int main() {
     }
 #endif
 
+    setupScreens(font);
+
     loadWinsCount();
     bool inMenu = true;
-    generateMazeSimple();
+    bool hasSave = saveFileExists(); // nothing saves or deletes while the menu is up
+    newMaze();
 
     sf::Clock autosaveClock; autosaveClock.restart();
 
+    // fresh board, both players on the start, countdown
+    auto startRace = [&]() {
+        if (!mazeUnplayed) newMaze();
+        mazeUnplayed = false;
+        player1X = maze.startX; player1Y = maze.startY; player2X = maze.startX; player2Y = maze.startY;
+        player1Reached = false; player2Reached = false; countdownTicks = 120;
+        if (botLevel >= 0) bot.reset(botLevel, maze.seed);
+        spawnSwarm();
+        shifter.reset(maze, maze.seed);
+        gameMode = MODE_COUNTDOWN; if (backgroundMusic.getStatus() != sf::SoundSource::Playing) backgroundMusic.play();
+    };
+
+    // flag1 / flag2: that player reached the goal on this move
+    auto finishRace = [&](bool flag1, bool flag2) {
+        if (!flag1 && !flag2) return;
+        if (flag1 && flag2) { saveWinToHistory("Tie"); }
+        else if (flag1) { saveWinToHistory(player1Name); player1Wins++; saveWinsCount(); }
+        else { saveWinToHistory(player2Name); player2Wins++; saveWinsCount(); }
+        gameMode = MODE_FINISHED; saveGameStateToFile();
+        if (backgroundMusic.getStatus() == sf::SoundSource::Playing) backgroundMusic.stop();
+        if (victoryMusic.getStatus() != sf::SoundSource::Playing) victoryMusic.play();
+    };
+
     while (window.isOpen()) {
+        // a screen with nothing moving on it sleeps until the next event
+        bool idleScreen = inMenu ? (poolSize <= 0 || seedPinned || mazePool.readyCount() == mazePool.capacity())
+                                 : (gameMode == MODE_ENTER_P1 || gameMode == MODE_ENTER_P2 || gameMode == MODE_PAUSED || gameMode == MODE_FINISHED);
         sf::Event e;
-        while (window.pollEvent(e)) {
+        bool pending;
+        if (idleScreen && !redraw && !unsaved) {
+            pending = window.waitEvent(e);
+            wakeClock.restart();
+            wokeUp = true;
+        }
+        else pending = window.pollEvent(e);
+        frameClock.restart();
+        int modeBefore = gameMode;
+        for (; pending; pending = window.pollEvent(e)) {
+            // nothing reads the mouse, so moving it changes nothing
+            if (e.type != sf::Event::MouseMoved) redraw = true;
             if (e.type == sf::Event::Closed) { if (!inMenu) saveGameStateToFile(); window.close(); }
 
             if (inMenu) {
-                bool hasSave = saveFileExists();
                 if (e.type == sf::Event::KeyPressed) {
                     if (e.key.code == sf::Keyboard::Escape) window.close();
                     if (e.key.code == sf::Keyboard::R) { resetWinCounters(); }
+                    if (e.key.code == sf::Keyboard::G) { mazeGenerator = (mazeGenerator + 1) % GEN_COUNT; mazePool.setWanted(boardW, boardH, mazeGenerator, mazeOptions); }
+                    if (e.key.code == sf::Keyboard::B) { botLevel = (botLevel + 2) % (BOT_LEVEL_COUNT + 1) - 1; }
+                    if (e.key.code == sf::Keyboard::E) {
+                        int next = 0;
+                        for (int i = 0; i < SWARM_SIZE_COUNT; i++) if (SWARM_SIZES[i] == swarmSize) next = (i + 1) % SWARM_SIZE_COUNT;
+                        swarmSize = SWARM_SIZES[next];
+                    }
+                    if (e.key.code == sf::Keyboard::S) shiftingWalls = !shiftingWalls;
 
                     // New game
                     if (e.key.code == sf::Keyboard::N) {
                         deleteSaveFile();
-                        generateMazeSimple();
+                        bool resized = (maze.width != boardW || maze.height != boardH);
+                        if (resized) { maze.resize(boardW, boardH); layoutWindow(window); }
+                        // the menu's board is still unplayed unless G picked another generator
+                        if (resized || !mazeUnplayed || maze.generator != mazeGenerator) newMaze();
                         player1Name = ""; player2Name = "";
-                        player1X = startX; player1Y = startY; player2X = startX; player2Y = startY;
+                        player1X = maze.startX; player1Y = maze.startY; player2X = maze.startX; player2Y = maze.startY;
                         player1Reached = false; player2Reached = false; countdownTicks = 120;
                         gameMode = MODE_ENTER_P1; inMenu = false; autosaveClock.restart();
                         // background music will start when countdown begins
@@ -420,12 +947,15 @@ int main() {
 
                     // Continue saved game
                     if (e.key.code == sf::Keyboard::C && hasSave) {
-                        if (!loadGameStateFromFile()) { generateMazeSimple(); gameMode = MODE_ENTER_P1; countdownTicks = 120; }
+                        if (!loadGameStateFromFile()) { maze.resize(boardW, boardH); newMaze(); gameMode = MODE_ENTER_P1; countdownTicks = 120; }
+                        layoutWindow(window);
                         inMenu = false; autosaveClock.restart();
                         if (gameMode == MODE_PLAYING || gameMode == MODE_COUNTDOWN) { if (backgroundMusic.getStatus() != sf::SoundSource::Playing) backgroundMusic.play(); }
+                        if (botLevel >= 0) bot.reset(botLevel, maze.seed);
+                        spawnSwarm();
+                        shifter.reset(maze, maze.seed);
                     }
                 }
-                drawMenuScreen(window, font, hasSave);
                 continue; // skip rest of event processing
             }
 
@@ -441,14 +971,10 @@ int main() {
                     if (e.key.code == sf::Keyboard::BackSpace) { if (!ref.empty()) ref.pop_back(); }
                     else if (e.key.code == sf::Keyboard::Enter) {
                         if (!ref.empty()) {
-                            if (gameMode == MODE_ENTER_P1) gameMode = MODE_ENTER_P2;
-                            else {
-                                // both names entered, start
-                                generateMazeSimple();
-                                player1X = startX; player1Y = startY; player2X = startX; player2Y = startY;
-                                player1Reached = false; player2Reached = false; countdownTicks = 120;
-                                gameMode = MODE_COUNTDOWN; if (backgroundMusic.getStatus() != sf::SoundSource::Playing) backgroundMusic.play();
-                            }
+                            // the bot needs no name entry
+                            if (gameMode == MODE_ENTER_P1 && botLevel >= 0) { player2Name = "Bot " + string(botLevelName(botLevel)); startRace(); }
+                            else if (gameMode == MODE_ENTER_P1) gameMode = MODE_ENTER_P2;
+                            else startRace(); // both names entered
                         }
                     }
                 }
@@ -468,6 +994,8 @@ int main() {
                 if (backgroundMusic.getStatus() != sf::SoundSource::Playing) backgroundMusic.play();
             }
 
+            if (gameMode == MODE_PLAYING && e.type == sf::Event::KeyPressed && e.key.code == sf::Keyboard::H) showHints = !showHints;
+
             // PLAYER MOVEMENT when playing
             if (gameMode == MODE_PLAYING && e.type == sf::Event::KeyPressed) {
                 bool flag1 = false, flag2 = false;
@@ -478,34 +1006,20 @@ int main() {
                     if (e.key.code == sf::Keyboard::S) ny++;
                     if (e.key.code == sf::Keyboard::A) nx--;
                     if (e.key.code == sf::Keyboard::D) nx++;
-                    if (nx >= 0 && nx < MAZE_W && ny >= 0 && ny < MAZE_H && maze[ny][nx] == 0) { player1X = nx; player1Y = ny; }
-                    if (player1X == goalX && player1Y == goalY) { player1Reached = true; flag1 = true; }
+                    if (maze.isOpen(nx, ny) && (nx != player1X || ny != player1Y)) { player1X = nx; player1Y = ny; followPlayer(0); }
+                    if (player1X == maze.goalX && player1Y == maze.goalY) { player1Reached = true; flag1 = true; }
                 }
-                if (!player2Reached) {
+                if (!player2Reached && botLevel < 0) {
                     nx = player2X; ny = player2Y;
                     if (e.key.code == sf::Keyboard::Up) ny--;
                     if (e.key.code == sf::Keyboard::Down) ny++;
                     if (e.key.code == sf::Keyboard::Left) nx--;
                     if (e.key.code == sf::Keyboard::Right) nx++;
-                    if (nx >= 0 && nx < MAZE_W && ny >= 0 && ny < MAZE_H && maze[ny][nx] == 0) { player2X = nx; player2Y = ny; }
-                    if (player2X == goalX && player2Y == goalY) { player2Reached = true; flag2 = true; }
+                    if (maze.isOpen(nx, ny) && (nx != player2X || ny != player2Y)) { player2X = nx; player2Y = ny; followPlayer(1); }
+                    if (player2X == maze.goalX && player2Y == maze.goalY) { player2Reached = true; flag2 = true; }
                 }
 
-                if (flag1 && flag2) {
-                    gameMode = MODE_FINISHED; saveWinToHistory("Tie"); saveGameStateToFile();
-                    if (backgroundMusic.getStatus() == sf::SoundSource::Playing) backgroundMusic.stop();
-                    if (victoryMusic.getStatus() != sf::SoundSource::Playing) victoryMusic.play();
-                }
-                else if (flag1) {
-                    gameMode = MODE_FINISHED; saveWinToHistory(player1Name); player1Wins++; saveWinsCount(); saveGameStateToFile();
-                    if (backgroundMusic.getStatus() == sf::SoundSource::Playing) backgroundMusic.stop();
-                    if (victoryMusic.getStatus() != sf::SoundSource::Playing) victoryMusic.play();
-                }
-                else if (flag2) {
-                    gameMode = MODE_FINISHED; saveWinToHistory(player2Name); player2Wins++; saveWinsCount(); saveGameStateToFile();
-                    if (backgroundMusic.getStatus() == sf::SoundSource::Playing) backgroundMusic.stop();
-                    if (victoryMusic.getStatus() != sf::SoundSource::Playing) victoryMusic.play();
-                }
+                finishRace(flag1, flag2);
             }
 
             // Restart after finished
@@ -521,15 +1035,71 @@ int main() {
             if (countdownTicks <= 0) { countdownTicks = 120; gameMode = MODE_PLAYING; }
         }
 
-        // Autosave every second
+        // Bot move, one tick per frame
+        if (gameMode == MODE_PLAYING && botLevel >= 0 && !player2Reached) {
+            static const int dx[4] = { 0, 0, -1, 1 };
+            static const int dy[4] = { -1, 1, 0, 0 };
+            int d = bot.tick(maze, goalField, player2X, player2Y);
+            if (d >= 0 && maze.isOpen(player2X + dx[d], player2Y + dy[d])) { player2X += dx[d]; player2Y += dy[d]; followPlayer(1); redraw = true; }
+            if (player2X == maze.goalX && player2Y == maze.goalY) { player2Reached = true; finishRace(false, true); }
+        }
+
+        // Shifting walls: at most one tile try per frame; enemies caught
+        // inside a new wall step out of it
+        if (gameMode == MODE_PLAYING && shiftingWalls) {
+            int keepX[2] = { player1X, player2X }, keepY[2] = { player1Y, player2Y };
+            FlowField* flows[3] = { &playerField[0], &playerField[1], &startField };
+            if (shifter.tick(maze, goalField, flows, swarm.size() > 0 ? 3 : 0, keepX, keepY, 2)) {
+                boardEdits++;
+                gapOracleStale = false; // would be out of date at once
+                swarm.leaveWalls(maze);
+                redraw = true;
+                if (renderBackend == RENDER_SHADER) shaderBoard.updateCells(maze, shifter.changed());
+                else mazeMesh.updateCells(maze, shifter.changed());
+            }
+        }
+
+        // Chasers: the fields already followed every step, a slice of the swarm steps
+        if (gameMode == MODE_PLAYING && swarm.size() > 0) {
+            unsigned hunted = (player1Reached || swarmGrace[0] > 0 ? 0u : 1u) | (player2Reached || swarmGrace[1] > 0 ? 0u : 2u);
+            unsigned caught = swarm.tick(playerField, 2, hunted);
+            redraw = true;
+            for (int p = 0; p < 2; p++) {
+                if (swarmGrace[p] > 0) swarmGrace[p]--;
+                if (!(caught & (1u << p))) continue;
+                if (p == 0) { player1X = maze.startX; player1Y = maze.startY; }
+                else { player2X = maze.startX; player2Y = maze.startY; }
+                playerField[p] = startField;
+                swarmGrace[p] = SWARM_GRACE_TICKS;
+            }
+        }
+
+        if (gameMode != modeBefore || (!inMenu && cameraMoving)) redraw = true;
+        if (inMenu && poolSize > 0 && !seedPinned && mazePool.readyCount() != menuPoolShown) redraw = true;
+        if (redraw && !inMenu) unsaved = true;
+
+        // Draw current screen, if it changed; otherwise nothing calls
+        // display() to hold the tick rate, so sleep out the tick here
+        if (redraw) {
+            redraw = false;
+            if (!inMenu) drawGameScreen(window);
+            else drawMenuScreen(window, hasSave);
+        }
+        else {
+            wokeUp = false;
+            sf::Time rest = sf::seconds(1.0f / TICKS_PER_SECOND) - frameClock.getElapsedTime();
+            if (rest > sf::Time::Zero) sf::sleep(rest);
+        }
+
+        // Autosave every second (after the frame, so a wake-up shows first)
         if (!inMenu && autosaveClock.getElapsedTime().asSeconds() >= 1.0f) {
             saveGameStateToFile(); autosaveClock.restart();
+            unsaved = false;
         }
-
-        // Draw current screen
-        if (!inMenu) drawGameScreen(window, font);
-        else drawMenuScreen(window, font, saveFileExists());
     }
 
+    mazePool.stop();
+    if (poolSize > 0 && !seedPinned)
+        cout << "Maze pool: " << mazePool.hits() << " hits, " << mazePool.misses() << " misses (pool size " << poolSize << ")" << endl;
     return 0;
 }
\ No newline at end of file
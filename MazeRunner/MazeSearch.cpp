@@ -0,0 +1,226 @@
+#include "MazeSearch.h"
+#include <algorithm>
+#include <cstdlib>
+
+using namespace std;
+
+// up, down, left, right; d ^ 1 is the opposite direction
+static const int stepX[4] = { 0, 0, -1, 1 };
+static const int stepY[4] = { -1, 1, 0, 0 };
+
+// -------------------- BUFFERS --------------------
+bool GridSearch::begin(const Maze& maze, int sx, int sy, int tx, int ty) {
+    width = maze.width;
+    height = maze.height;
+    size_t cells = (size_t)width * height;
+    if (cost.size() < cells) {
+        cost.assign(cells, 0);
+        fromDir.resize(cells);
+        base = 1;
+    }
+    // no room left above base for this board: start over
+    if (base == 0 || base > UINT32_MAX - (uint32_t)cells - 1) {
+        fill(cost.begin(), cost.end(), 0);
+        base = 1;
+    }
+    expandedCount = 0;
+    queue.clear();
+    open.clear();
+    return maze.isOpen(sx, sy) && maze.isOpen(tx, ty);
+}
+
+// every value written this query is below base + maxSteps + 1
+void GridSearch::finish(uint32_t maxSteps) {
+    base += maxSteps + 1;
+}
+
+size_t GridSearch::memoryBytes() const {
+    return cost.capacity() * sizeof(uint32_t) + fromDir.capacity() + parentJump.capacity() * sizeof(int) +
+        queue.capacity() * sizeof(int) + open.capacity() * sizeof(OpenNode);
+}
+
+void GridSearch::pushOpen(uint64_t key, int cell) {
+    open.push_back({ key, cell });
+    push_heap(open.begin(), open.end(), [](const OpenNode& a, const OpenNode& b) { return a.key > b.key; });
+}
+
+int GridSearch::popOpen() {
+    pop_heap(open.begin(), open.end(), [](const OpenNode& a, const OpenNode& b) { return a.key > b.key; });
+    int cell = open.back().cell;
+    open.pop_back();
+    return cell;
+}
+
+// f in the high half; low half is ~g so the deeper of two equal-f nodes wins
+static uint64_t openKey(uint32_t f, uint32_t g) {
+    return ((uint64_t)f << 32) | (uint32_t)~g;
+}
+
+void GridSearch::tracePath(int target, vector<int>& path) const {
+    path.assign(steps(target) + 1, 0);
+    int c = target;
+    for (int i = (int)path.size() - 1; i >= 0; i--) {
+        path[i] = c;
+        if (i == 0) break;
+        int d = fromDir[c] & 3;
+        c -= stepY[d] * width + stepX[d];
+    }
+}
+
+// -------------------- BFS --------------------
+int GridSearch::bfs(const Maze& maze, int sx, int sy, int tx, int ty, vector<int>* path) {
+    if (!begin(maze, sx, sy, tx, ty)) return -1;
+    int start = sy * width + sx, target = ty * width + tx;
+
+    cost[start] = base;
+    queue.push_back(start);
+    uint32_t maxSteps = 0;
+    for (size_t head = 0; head < queue.size(); head++) {
+        int c = queue[head];
+        expandedCount++;
+        if (c == target) break;
+        int x = c % width, y = c / width;
+        uint32_t next = cost[c] + 1;
+        for (int k = 0; k < 4; k++) {
+            int nx = x + stepX[k], ny = y + stepY[k];
+            if (!maze.isOpen(nx, ny)) continue;
+            int n = ny * width + nx;
+            if (reached(n)) continue;
+            cost[n] = next;
+            fromDir[n] = (uint8_t)k;
+            queue.push_back(n);
+        }
+        maxSteps = next - base;
+    }
+
+    int result = reached(target) ? (int)steps(target) : -1;
+    if (result >= 0 && path) tracePath(target, *path);
+    finish(maxSteps);
+    return result;
+}
+
+// -------------------- A* --------------------
+int GridSearch::astar(const Maze& maze, int sx, int sy, int tx, int ty, vector<int>* path) {
+    if (!begin(maze, sx, sy, tx, ty)) return -1;
+    int start = sy * width + sx, target = ty * width + tx;
+
+    cost[start] = base;
+    pushOpen(openKey(abs(sx - tx) + abs(sy - ty), 0), start);
+    uint32_t maxSteps = 0;
+    while (!open.empty()) {
+        uint32_t g = ~(uint32_t)open.front().key;
+        int c = popOpen();
+        if (g != steps(c)) continue; // a shorter way was found after this was queued
+        expandedCount++;
+        if (c == target) break;
+
+        int x = c % width, y = c / width;
+        uint32_t ng = g + 1;
+        for (int k = 0; k < 4; k++) {
+            int nx = x + stepX[k], ny = y + stepY[k];
+            if (!maze.isOpen(nx, ny)) continue;
+            int n = ny * width + nx;
+            if (reached(n) && steps(n) <= ng) continue;
+            cost[n] = base + ng;
+            fromDir[n] = (uint8_t)k;
+            pushOpen(openKey(ng + abs(nx - tx) + abs(ny - ty), ng), n);
+        }
+        if (ng > maxSteps) maxSteps = ng;
+    }
+
+    int result = reached(target) ? (int)steps(target) : -1;
+    if (result >= 0 && path) tracePath(target, *path);
+    finish(maxSteps);
+    return result;
+}
+
+// -------------------- JPS --------------------
+// Walks from (x, y) in direction d along a corridor. Stops at the target,
+// a junction or a dead end; x, y, d end up at the stop and the last step.
+static int followCorridor(const Maze& maze, int& x, int& y, int& d, int tx, int ty) {
+    int length = 0;
+    while (true) {
+        x += stepX[d]; y += stepY[d];
+        length++;
+        if (x == tx && y == ty) return length;
+
+        int exits = 0, exitDir = 0;
+        for (int k = 0; k < 4; k++) {
+            if (k == (d ^ 1) || !maze.isOpen(x + stepX[k], y + stepY[k])) continue;
+            exits++;
+            exitDir = k;
+        }
+        if (exits != 1) return length;
+        d = exitDir;
+    }
+}
+
+int GridSearch::jps(const Maze& maze, int sx, int sy, int tx, int ty, vector<int>* path) {
+    if (!begin(maze, sx, sy, tx, ty)) return -1;
+    int start = sy * width + sx, target = ty * width + tx;
+    if (parentJump.size() < cost.size()) parentJump.resize(cost.size());
+
+    // fromDir: bits 0-1 the direction the jump left its parent,
+    // bits 2-3 the direction it arrived in
+    cost[start] = base;
+    fromDir[start] = 0;
+    parentJump[start] = -1;
+    pushOpen(openKey(abs(sx - tx) + abs(sy - ty), 0), start);
+    uint32_t maxSteps = 0;
+    while (!open.empty()) {
+        uint32_t g = ~(uint32_t)open.front().key;
+        int c = popOpen();
+        if (g != steps(c)) continue;
+        expandedCount++;
+        if (c == target) break;
+
+        int cx = c % width, cy = c / width;
+        int back = (c == start) ? -1 : ((fromDir[c] >> 2) ^ 1);
+        for (int k = 0; k < 4; k++) {
+            if (k == back || !maze.isOpen(cx + stepX[k], cy + stepY[k])) continue;
+            int x = cx, y = cy, d = k;
+            uint32_t ng = g + followCorridor(maze, x, y, d, tx, ty);
+            int n = y * width + x;
+
+            // a dead end that is not the target leads nowhere
+            if (n != target) {
+                int exits = 0;
+                for (int j = 0; j < 4; j++) exits += maze.isOpen(x + stepX[j], y + stepY[j]);
+                if (exits <= 1) continue;
+            }
+            if (reached(n) && steps(n) <= ng) continue;
+            cost[n] = base + ng;
+            fromDir[n] = (uint8_t)(k | (d << 2));
+            parentJump[n] = c;
+            pushOpen(openKey(ng + abs(x - tx) + abs(y - ty), ng), n);
+            if (ng > maxSteps) maxSteps = ng;
+        }
+    }
+
+    int result = reached(target) ? (int)steps(target) : -1;
+    if (result >= 0 && path) traceJumps(maze, start, target, *path);
+    finish(maxSteps);
+    return result;
+}
+
+// Re-walks every jump from its parent to rebuild the cell path
+void GridSearch::traceJumps(const Maze& maze, int start, int target, vector<int>& path) const {
+    vector<int> jumps;
+    for (int c = target; c != start; c = parentJump[c]) jumps.push_back(c);
+    jumps.push_back(start);
+    reverse(jumps.begin(), jumps.end());
+
+    path.assign(1, start);
+    for (size_t i = 1; i < jumps.size(); i++) {
+        int x = jumps[i - 1] % width, y = jumps[i - 1] / width;
+        int d = fromDir[jumps[i]] & 3;
+        while (true) {
+            x += stepX[d]; y += stepY[d];
+            path.push_back(y * width + x);
+            if (y * width + x == jumps[i]) break;
+            // inside a corridor: the one way on that is not back
+            for (int k = 0; k < 4; k++)
+                if (k != (d ^ 1) && maze.isOpen(x + stepX[k], y + stepY[k])) { d = k; break; }
+        }
+    }
+}
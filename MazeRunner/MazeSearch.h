@@ -0,0 +1,51 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "Maze.h"
+
+// -------------------- POINT-TO-POINT SEARCH --------------------
+// Shortest path between two arbitrary cells (player to player, player to
+// item). One GridSearch is meant to be kept and reused: its buffers grow to
+// the biggest board seen and are never cleared between queries (a rising
+// base value marks old entries as unvisited), so a query does not allocate.
+//
+// All three return the number of steps, -1 when there is no path. path, when
+// given, receives the grid indices (y * width + x) from start to target.
+class GridSearch {
+public:
+    // Plain BFS that stops at the target
+    int bfs(const Maze& maze, int sx, int sy, int tx, int ty, std::vector<int>* path = nullptr);
+
+    // A* with the Manhattan distance (exact on a 4-connected grid with no
+    // walls, never an overestimate); ties go to the deeper node
+    int astar(const Maze& maze, int sx, int sy, int tx, int ty, std::vector<int>* path = nullptr);
+
+    // Jump point search adapted to 4-connected corridors: a jump follows a
+    // corridor, turning with it, until it hits a junction, a dead end or the
+    // target, so only those cells enter the open list
+    int jps(const Maze& maze, int sx, int sy, int tx, int ty, std::vector<int>* path = nullptr);
+
+    // Nodes taken off the open list / queue by the last query
+    long long expanded() const { return expandedCount; }
+    size_t memoryBytes() const;
+
+private:
+    int width = 0, height = 0;
+    std::vector<uint32_t> cost;     // base + steps; below base = not reached this query
+    std::vector<uint8_t> fromDir;   // direction of the step (or jump) that reached the cell
+    std::vector<int> parentJump;    // jps: previous jump point
+    uint32_t base = 0;
+    std::vector<int> queue;
+    struct OpenNode { uint64_t key; int cell; };
+    std::vector<OpenNode> open;     // binary heap, smallest key first
+    long long expandedCount = 0;
+
+    bool begin(const Maze& maze, int sx, int sy, int tx, int ty);
+    void finish(uint32_t maxSteps);
+    bool reached(int c) const { return cost[c] >= base; }
+    uint32_t steps(int c) const { return cost[c] - base; }
+    void pushOpen(uint64_t key, int cell);
+    int popOpen();
+    void tracePath(int target, std::vector<int>& path) const;
+    void traceJumps(const Maze& maze, int start, int target, std::vector<int>& path) const;
+};
@@ -0,0 +1,93 @@
+#include "MazeShader.h"
+#include <algorithm>
+#include "MazeMesh.h"
+
+using namespace std;
+
+// texCoords are board cells; cell x lives in channel x % 4 of texel x / 4
+const char* const BOARD_FRAGMENT_SHADER = R"(
+uniform sampler2D maze;
+uniform vec2 texSize;
+uniform vec2 goal;
+uniform vec4 wallColor;
+uniform vec4 openColor;
+uniform vec4 goalColor;
+
+void main() {
+    vec2 cell = floor(gl_TexCoord[0].xy);
+    float texel = floor(cell.x / 4.0);
+    vec4 t = texture2D(maze, (vec2(texel, cell.y) + 0.5) / texSize);
+    float k = cell.x - 4.0 * texel;
+    float v = k < 0.5 ? t.r : (k < 1.5 ? t.g : (k < 2.5 ? t.b : t.a));
+    vec4 color = v > 0.5 ? wallColor : openColor;
+    if (cell == goal) color = goalColor;
+    gl_FragColor = color;
+}
+)";
+
+// rows per upload while building, so the staging copy stays small
+const int SHADER_BUILD_ROWS = 256;
+
+void ShaderBoard::upload(const Maze& maze, int tx0, int y0, int tw, int rows) {
+    staging.resize((size_t)tw * rows * 4);
+    for (int y = 0; y < rows; y++) {
+        sf::Uint8* out = &staging[(size_t)y * tw * 4];
+        for (int i = 0; i < tw * 4; i++) {
+            int x = tx0 * 4 + i;
+            out[i] = (x >= width || maze.isWall(x, y0 + y)) ? 255 : 0;
+        }
+    }
+    texture.update(staging.data(), (unsigned)tw, (unsigned)rows, (unsigned)tx0, (unsigned)y0);
+}
+
+bool ShaderBoard::reset(const Maze& maze, int size) {
+    if (!isAvailable()) return false;
+    if (!shaderLoaded) shaderLoaded = shader.loadFromMemory(BOARD_FRAGMENT_SHADER, sf::Shader::Fragment);
+    if (!shaderLoaded) return false;
+    width = maze.width;
+    height = maze.height;
+    cellSize = size;
+    texelsWide = (width + 3) / 4;
+    unsigned most = sf::Texture::getMaximumSize();
+    if ((unsigned)texelsWide > most || (unsigned)height > most || !texture.create((unsigned)texelsWide, (unsigned)height)) return false;
+    texture.setSmooth(false);
+    for (int y0 = 0; y0 < height; y0 += SHADER_BUILD_ROWS) upload(maze, 0, y0, texelsWide, min(SHADER_BUILD_ROWS, height - y0));
+
+    shader.setUniform("maze", texture);
+    shader.setUniform("texSize", sf::Glsl::Vec2((float)texelsWide, (float)height));
+    shader.setUniform("goal", sf::Glsl::Vec2((float)maze.goalX, (float)maze.goalY));
+    shader.setUniform("wallColor", sf::Glsl::Vec4(WALL_COLOR));
+    shader.setUniform("openColor", sf::Glsl::Vec4(OPEN_COLOR));
+    shader.setUniform("goalColor", sf::Glsl::Vec4(sf::Color::Yellow));
+    return true;
+}
+
+void ShaderBoard::updateCells(const Maze& maze, const vector<int>& cells) {
+    if (maze.width != width || maze.height != height || cells.empty()) return;
+    // one upload for the texels around every change (a shift stays in one tile)
+    int tx0 = texelsWide, tx1 = -1, y0 = height, y1 = -1;
+    for (int c : cells) {
+        int tx = c % width / 4, y = c / width;
+        tx0 = min(tx0, tx); tx1 = max(tx1, tx);
+        y0 = min(y0, y); y1 = max(y1, y);
+    }
+    upload(maze, tx0, y0, tx1 - tx0 + 1, y1 - y0 + 1);
+}
+
+void ShaderBoard::draw(sf::RenderTarget& target) {
+    if (width <= 0) return;
+    // one quad: the view rectangle cut to the board
+    const sf::View& view = target.getView();
+    sf::Vector2f half = view.getSize() / 2.0f, center = view.getCenter();
+    float left = max(0.0f, center.x - half.x), top = max(0.0f, center.y - half.y);
+    float right = min((float)(width * cellSize), center.x + half.x), bottom = min((float)(height * cellSize), center.y + half.y);
+    if (left >= right || top >= bottom) return;
+
+    sf::Vertex quad[4];
+    quad[0].position = sf::Vector2f(left, top);
+    quad[1].position = sf::Vector2f(right, top);
+    quad[2].position = sf::Vector2f(right, bottom);
+    quad[3].position = sf::Vector2f(left, bottom);
+    for (int k = 0; k < 4; k++) quad[k].texCoords = quad[k].position / (float)cellSize;
+    target.draw(quad, 4, sf::Quads, sf::RenderStates(&shader));
+}
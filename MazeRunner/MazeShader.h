@@ -0,0 +1,35 @@
+#pragma once
+#include <vector>
+#include <SFML/Graphics.hpp>
+#include "Maze.h"
+
+// -------------------- SHADER BOARD --------------------
+// The other way to draw the board (--render shader): the walls packed into
+// a texture, four cells per RGBA texel with one byte each (255 = wall), and
+// a single quad over the part of the board in view whose fragment shader
+// looks up the cell under each pixel. Cost goes with pixels, not cells, and
+// any zoom comes for free. Wall edits re-upload the rectangle of texels
+// around them. The shader is GLSL 1.10 so it also runs on Mesa's software
+// GL (llvmpipe).
+class ShaderBoard {
+public:
+    static bool isAvailable() { return sf::Shader::isAvailable(); }
+
+    // New maze or cell size. False when this board can't be drawn this way
+    // (shader failed to build, or the board is bigger than a texture).
+    bool reset(const Maze& maze, int cellSize);
+    void updateCells(const Maze& maze, const std::vector<int>& cells); // grid indices
+
+    void draw(sf::RenderTarget& target);
+
+private:
+    sf::Texture texture;
+    sf::Shader shader;
+    bool shaderLoaded = false;
+    int width = 0, height = 0, cellSize = 0;
+    int texelsWide = 0;
+    std::vector<sf::Uint8> staging;
+
+    // texels [tx0, tx0 + tw) of rows [y0, y0 + rows) from the maze, uploaded
+    void upload(const Maze& maze, int tx0, int y0, int tw, int rows);
+};
@@ -0,0 +1,76 @@
+#include "MazeShift.h"
+#include <algorithm>
+#include "MazeGen.h"
+
+using namespace std;
+
+void WallShifter::reset(const Maze& maze, uint64_t seed) {
+    rng.reseed(seed, 0x5417);
+    repair.reserve((size_t)maze.width * maze.height);
+    wait = SHIFT_INTERVAL_TICKS;
+    shiftCount = putBackCount = 0;
+    flipped.clear();
+}
+
+size_t WallShifter::memoryBytes() const {
+    return (flipped.capacity() + edges.capacity() + parent.capacity()) * sizeof(int) + repair.memoryBytes();
+}
+
+bool WallShifter::tick(Maze& maze, DistanceField& goalField, FlowField* const* flows, int flowCount,
+                       const int* keepX, const int* keepY, int keepCount) {
+    flipped.clear();
+    if (--wait > 0) return false;
+    wait = 1; // until a try sticks, one per tick
+
+    // pick a tile of rooms (cells, in MazeGen terms); edge tiles may be smaller
+    int cw = cellsWide(maze), ch = cellsHigh(maze);
+    int tilesX = (cw + SHIFT_TILE_ROOMS - 1) / SHIFT_TILE_ROOMS, tilesY = (ch + SHIFT_TILE_ROOMS - 1) / SHIFT_TILE_ROOMS;
+    int cx0 = (int)rng.below(tilesX) * SHIFT_TILE_ROOMS, cy0 = (int)rng.below(tilesY) * SHIFT_TILE_ROOMS;
+    int tw = min(SHIFT_TILE_ROOMS, cw - cx0), th = min(SHIFT_TILE_ROOMS, ch - cy0);
+    for (int cy = 0; cy < th; cy++)
+        for (int cx = 0; cx < tw; cx++)
+            if (maze.isWall(2 * (cx0 + cx) + 1, 2 * (cy0 + cy) + 1)) return false; // not a room grid here
+
+    // inner walls as Kruskal edges (room * 2 + 0 = east, + 1 = south),
+    // shuffled, with the ones a player stands on in front
+    edges.clear();
+    for (int cy = 0; cy < th; cy++)
+        for (int cx = 0; cx < tw; cx++) {
+            if (cx + 1 < tw) edges.push_back((cy * tw + cx) * 2);
+            if (cy + 1 < th) edges.push_back((cy * tw + cx) * 2 + 1);
+        }
+    if (!edges.empty()) shuffleArray(edges.data(), (int)edges.size(), rng);
+    auto gridX = [&](int e) { return 2 * (cx0 + e / 2 % tw) + 2 - e % 2; };
+    auto gridY = [&](int e) { return 2 * (cy0 + e / 2 / tw) + 1 + e % 2; };
+    int forced = 0;
+    for (size_t i = 0; i < edges.size(); i++)
+        for (int k = 0; k < keepCount; k++)
+            if (keepX[k] == gridX(edges[i]) && keepY[k] == gridY(edges[i])) { swap(edges[i], edges[forced++]); break; }
+
+    parent.resize((size_t)tw * th);
+    for (int c = 0; c < tw * th; c++) parent[c] = c;
+    for (int e : edges) {
+        int a = findSet(parent, e / 2), b = findSet(parent, e / 2 + (e % 2 ? tw : 1));
+        bool wall = (a == b);
+        if (!wall) parent[a] = b;
+        int x = gridX(e), y = gridY(e);
+        if (maze.isWall(x, y) != wall) {
+            maze.setWall(x, y, wall);
+            flipped.push_back(y * maze.width + x);
+        }
+    }
+    if (flipped.empty()) { wait = SHIFT_INTERVAL_TICKS; return false; }
+
+    bool fits = true;
+    for (int f = 0; f < flowCount && fits; f++) fits = flows[f]->repairFits(maze, flipped, SHIFT_REPAIR_CELLS);
+    if (!fits || repair.apply(maze, goalField, flipped, SHIFT_REPAIR_CELLS) < 0) {
+        for (int c : flipped) maze.setWall(c % maze.width, c / maze.width, !maze.isWall(c % maze.width, c / maze.width));
+        flipped.clear();
+        putBackCount++;
+        return false;
+    }
+    for (int f = 0; f < flowCount; f++) flows[f]->wallsChanged(maze, flipped);
+    shiftCount++;
+    wait = SHIFT_INTERVAL_TICKS;
+    return true;
+}
@@ -0,0 +1,48 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "Maze.h"
+#include "MazeRepair.h"
+#include "MazeSolve.h"
+#include "MazeSwarm.h"
+#include "Rng.h"
+
+// -------------------- SHIFTING WALLS --------------------
+// Every SHIFT_INTERVAL_TICKS one tile of SHIFT_TILE_ROOMS x SHIFT_TILE_ROOMS
+// rooms gets a fresh random spanning tree for the walls inside it. Passages
+// across the tile's edge are left alone and every room of the tile ends up
+// joined to every other, so whatever was connected before still is. A
+// passage with a player on it always goes into the new tree.
+//
+// A try costs the tile plus repairs of the goal field and the chasers' flow
+// fields, each capped at SHIFT_REPAIR_CELLS. A shift that would need more
+// (cutting the one way through a perfect maze, say) is put back and another
+// tile is tried the next tick, so no tick ever pays for a rebuild. Each
+// shift adds loops, and on a loopy board nearly every repair is small.
+const int SHIFT_TILE_ROOMS = 8;
+const int SHIFT_INTERVAL_TICKS = 90;    // 1.5 s at 60 ticks per second
+const int SHIFT_REPAIR_CELLS = 1 << 13;
+
+class WallShifter {
+public:
+    void reset(const Maze& maze, uint64_t seed);
+
+    // One game tick. keepX / keepY: cells that must stay open (the
+    // players). Returns true when walls moved; changed() lists them and
+    // goalField and the flows have already been repaired.
+    bool tick(Maze& maze, DistanceField& goalField, FlowField* const* flows, int flowCount,
+              const int* keepX, const int* keepY, int keepCount);
+
+    const std::vector<int>& changed() const { return flipped; } // grid indices
+    int shifts() const { return shiftCount; }
+    int putBack() const { return putBackCount; }
+    size_t memoryBytes() const;
+
+private:
+    Rng rng;
+    int wait = SHIFT_INTERVAL_TICKS;
+    int shiftCount = 0, putBackCount = 0;
+    std::vector<int> flipped;
+    std::vector<int> edges, parent;     // one tile's inner walls, union-find on its rooms
+    FieldRepair repair;
+};
@@ -0,0 +1,113 @@
+#include "MazeSolve.h"
+#include "MazeBitBfs.h"
+#include "MazeGraph.h"
+
+using namespace std;
+
+// -------------------- BFS --------------------
+long long bfsDistances(const Maze& maze, int sx, int sy, vector<int>& dist) {
+    int w = maze.width;
+    dist.assign((size_t)w * maze.height, -1);
+    if (!maze.isOpen(sx, sy)) return 0;
+
+    // every cell is queued once, so a flat array doubles as the queue
+    vector<int> queue;
+    queue.reserve(1024);
+    queue.push_back(sy * w + sx);
+    dist[queue[0]] = 0;
+
+    const int dx[4] = { 0, 0, -1, 1 };
+    const int dy[4] = { -1, 1, 0, 0 };
+    for (size_t head = 0; head < queue.size(); head++) {
+        int c = queue[head];
+        int x = c % w, y = c / w;
+        int d = dist[c] + 1;
+        for (int k = 0; k < 4; k++) {
+            int nx = x + dx[k], ny = y + dy[k];
+            if (!maze.isOpen(nx, ny)) continue;
+            int n = ny * w + nx;
+            if (dist[n] >= 0) continue;
+            dist[n] = d;
+            queue.push_back(n);
+        }
+    }
+    return (long long)queue.size();
+}
+
+int solveMaze(const Maze& maze, vector<int>* path) {
+    vector<int> dist;
+    bfsDistances(maze, maze.startX, maze.startY, dist);
+    int w = maze.width;
+    int goal = maze.goalY * w + maze.goalX;
+    int length = dist[goal];
+    if (length < 0 || !path) return length;
+
+    // walk back from the goal along decreasing distances
+    path->assign(length + 1, 0);
+    int x = maze.goalX, y = maze.goalY;
+    const int dx[4] = { 0, 0, -1, 1 };
+    const int dy[4] = { -1, 1, 0, 0 };
+    for (int d = length; d >= 0; d--) {
+        (*path)[d] = y * w + x;
+        if (d == 0) break;
+        for (int k = 0; k < 4; k++) {
+            int nx = x + dx[k], ny = y + dy[k];
+            if (maze.inGrid(nx, ny) && dist[ny * w + nx] == d - 1) { x = nx; y = ny; break; }
+        }
+    }
+    return length;
+}
+
+// -------------------- DISTANCE FIELD --------------------
+void DistanceField::build(const Maze& maze, int tx, int ty) {
+    width = maze.width; height = maze.height;
+    targetX = tx; targetY = ty;
+    BitBfs bfs;
+    bfs.run(maze, tx, ty, &dist);
+}
+
+int DistanceField::nextStep(int x, int y, int& nx, int& ny) const {
+    int d = at(x, y);
+    if (d <= 0) return -1;
+
+    const int dx[4] = { 0, 0, -1, 1 };
+    const int dy[4] = { -1, 1, 0, 0 };
+    for (int k = 0; k < 4; k++) {
+        if (at(x + dx[k], y + dy[k]) == d - 1) { nx = x + dx[k]; ny = y + dy[k]; return k; }
+    }
+    return -1;
+}
+
+// -------------------- STATS --------------------
+MazeStats computeMazeStats(const Maze& maze) {
+    MazeStats stats;
+    long long passages = 0;
+    // every cell, border included, so openCells is the same set the BFS below can reach
+    for (int y = 0; y < maze.height; y++) {
+        for (int x = 0; x < maze.width; x++) {
+            if (maze.isWall(x, y)) continue;
+            stats.openCells++;
+            int open = maze.isOpen(x - 1, y) + maze.isOpen(x + 1, y) + maze.isOpen(x, y - 1) + maze.isOpen(x, y + 1);
+            passages += maze.isOpen(x + 1, y) + maze.isOpen(x, y + 1);
+            if (open == 1) stats.deadEnds++;
+            else if (open == 2) stats.corridors++;
+            else if (open >= 3) stats.junctions++;
+        }
+    }
+
+    vector<int> dist;
+    long long reached = bfsDistances(maze, maze.startX, maze.startY, dist);
+    stats.connected = (reached == stats.openCells);
+    stats.loops = passages - (stats.openCells - 1);
+
+    JunctionGraph graph;
+    graph.build(maze);
+    graph.findDeadBranches();
+    stats.deadBranchCells = graph.deadBranchCells();
+
+    vector<int> path;
+    stats.solutionLength = solveMaze(maze, &path);
+    for (size_t i = 2; i < path.size(); i++)
+        if (path[i] - path[i - 1] != path[i - 1] - path[i - 2]) stats.solutionTurns++;
+    return stats;
+}
@@ -0,0 +1,52 @@
+#pragma once
+#include <vector>
+#include "Maze.h"
+
+// -------------------- BFS --------------------
+// Distances in steps from (sx, sy) over open grid cells, indexed y * width + x,
+// -1 where unreachable. Returns the number of cells reached.
+long long bfsDistances(const Maze& maze, int sx, int sy, std::vector<int>& dist);
+
+// Shortest start -> goal path length in steps, -1 if there is none. When path
+// is given it receives the grid indices from start to goal.
+int solveMaze(const Maze& maze, std::vector<int>* path);
+
+// -------------------- DISTANCE FIELD --------------------
+// Steps from every grid cell to one target (the goal by default), built once
+// per maze so the HUD, hints and bots look it up in O(1) instead of searching.
+// -1 on walls and unreachable cells.
+struct DistanceField {
+    int width = 0, height = 0;
+    int targetX = -1, targetY = -1;
+    std::vector<int> dist;
+
+    void build(const Maze& maze, int tx, int ty);
+    void buildToGoal(const Maze& maze) { build(maze, maze.goalX, maze.goalY); }
+    bool matches(const Maze& maze) const { return width == maze.width && height == maze.height && targetX == maze.goalX && targetY == maze.goalY; }
+
+    int at(int x, int y) const {
+        if ((unsigned)x >= (unsigned)width || (unsigned)y >= (unsigned)height) return -1;
+        return dist[(size_t)y * width + x];
+    }
+
+    // Neighbour one step closer to the target: direction 0 up, 1 down,
+    // 2 left, 3 right, or -1 when (x, y) is the target or cannot reach it.
+    int nextStep(int x, int y, int& nx, int& ny) const;
+
+    size_t memoryBytes() const { return dist.capacity() * sizeof(int); }
+};
+
+// -------------------- STATS --------------------
+struct MazeStats {
+    long long openCells = 0;
+    long long deadEnds = 0;    // open cells with one open neighbour
+    long long corridors = 0;   // exactly two
+    long long junctions = 0;   // three or four
+    long long loops = 0;       // extra passages beyond a spanning tree (0 = perfect)
+    long long deadBranchCells = 0; // open cells off every start -> goal path
+    bool connected = false;
+    int solutionLength = -1;   // steps start -> goal
+    int solutionTurns = 0;     // direction changes along that path
+};
+
+MazeStats computeMazeStats(const Maze& maze);
@@ -0,0 +1,167 @@
+#include "MazeStream.h"
+#include "MazeGen.h"
+
+using namespace std;
+
+// -------------------- SINKS --------------------
+void MazeFillSink::writeRow(const uint64_t* bits, int width) {
+    if (nextY >= maze.height || width != maze.width) return;
+    uint64_t* r = maze.row(nextY++);
+    for (int i = 0; i < maze.rowWords; i++) r[i] = bits[i];
+}
+
+void TextRowSink::writeRow(const uint64_t* bits, int width) {
+    line.resize(width + 1);
+    for (int x = 0; x < width; x++) line[x] = ((bits[x >> 6] >> (x & 63)) & 1) ? '1' : '0';
+    line[width] = '\n';
+    out.write(line.data(), line.size());
+}
+
+RowRingBuffer::RowRingBuffer(int w, int capacityRows) {
+    width = w;
+    rowWords = (w + 63) / 64;
+    capacity = capacityRows < 2 ? 2 : capacityRows;
+    rows.resize((size_t)rowWords * capacity);
+}
+
+void RowRingBuffer::writeRow(const uint64_t* bits, int w) {
+    unique_lock<mutex> guard(lock);
+    changed.wait(guard, [&] { return closed || written - first < capacity; });
+    if (closed || w != width) return;
+
+    uint64_t* dst = &rows[(size_t)(written % capacity) * rowWords];
+    for (int i = 0; i < rowWords; i++) dst[i] = bits[i];
+    written++;
+    changed.notify_all();
+}
+
+long long RowRingBuffer::firstRow() { lock_guard<mutex> guard(lock); return first; }
+long long RowRingBuffer::rowsWritten() { lock_guard<mutex> guard(lock); return written; }
+
+bool RowRingBuffer::waitForRow(long long y) {
+    unique_lock<mutex> guard(lock);
+    changed.wait(guard, [&] { return closed || written > y; });
+    return written > y;
+}
+
+bool RowRingBuffer::isWall(int x, long long y) {
+    lock_guard<mutex> guard(lock);
+    if (y < first || y >= written || x < 0 || x >= width) return true;
+    const uint64_t* r = &rows[(size_t)(y % capacity) * rowWords];
+    return (r[x >> 6] >> (x & 63)) & 1;
+}
+
+bool RowRingBuffer::readRow(long long y, uint64_t* bits) {
+    lock_guard<mutex> guard(lock);
+    if (y < first || y >= written) return false;
+    const uint64_t* r = &rows[(size_t)(y % capacity) * rowWords];
+    for (int i = 0; i < rowWords; i++) bits[i] = r[i];
+    return true;
+}
+
+void RowRingBuffer::releaseBefore(long long y) {
+    lock_guard<mutex> guard(lock);
+    if (y > written) y = written;
+    if (y > first) { first = y; changed.notify_all(); }
+}
+
+void RowRingBuffer::close() {
+    lock_guard<mutex> guard(lock);
+    closed = true;
+    changed.notify_all();
+}
+
+// -------------------- STREAMING ELLER --------------------
+void setRowBit(vector<uint64_t>& row, int x, bool wall) {
+    uint64_t m = 1ull << (x & 63);
+    if (wall) row[x >> 6] |= m; else row[x >> 6] &= ~m;
+}
+
+void EllerStream::begin(int gridWidth, MazeRowSink& sink, uint64_t seed) {
+    width = clampMazeSize(gridWidth);
+    cellsW = (width - 1) / 2;
+    rowWords = (width + 63) / 64;
+    rowsOut = 0;
+    rng.reseed(seed);
+
+    label.assign(cellsW, -1);
+    parent.assign(cellsW, 0);
+    seen.assign(cellsW, 0);
+    pick.assign(cellsW, 0);
+    used.assign(cellsW, 0);
+    down.assign(cellsW, 0);
+    cellRow.assign(rowWords, ~0ull);
+    wallRow.assign(rowWords, ~0ull);
+
+    emit(sink, wallRow); // top border
+}
+
+void EllerStream::emit(MazeRowSink& sink, vector<uint64_t>& row) {
+    sink.writeRow(row.data(), width);
+    rowsOut++;
+    for (int i = 0; i < rowWords; i++) row[i] = ~0ull;
+}
+
+void EllerStream::nextRow(MazeRowSink& sink, bool lastRow) {
+    // fresh labels for cells not joined from above
+    for (int l = 0; l < cellsW; l++) used[l] = 0;
+    for (int cx = 0; cx < cellsW; cx++) if (label[cx] >= 0) used[label[cx]] = 1;
+    int nextFree = 0;
+    for (int cx = 0; cx < cellsW; cx++) {
+        if (label[cx] >= 0) continue;
+        while (used[nextFree]) nextFree++;
+        label[cx] = nextFree;
+        used[nextFree] = 1;
+    }
+    for (int l = 0; l < cellsW; l++) parent[l] = l;
+
+    // join neighbours in different sets (always on the last row)
+    for (int cx = 0; cx < cellsW; cx++) {
+        setRowBit(cellRow, 2 * cx + 1, false);
+        if (cx + 1 == cellsW) break;
+        int a = findSet(parent, label[cx]);
+        int b = findSet(parent, label[cx + 1]);
+        if (a != b && (lastRow || rng.coin())) {
+            parent[b] = a;
+            setRowBit(cellRow, 2 * cx + 2, false);
+        }
+    }
+    for (int cx = 0; cx < cellsW; cx++) label[cx] = findSet(parent, label[cx]);
+
+    if (!lastRow) {
+        // every set goes down at least once: random picks, then one forced
+        // member per set chosen by reservoir sampling
+        for (int l = 0; l < cellsW; l++) { seen[l] = 0; pick[l] = -1; }
+        for (int cx = 0; cx < cellsW; cx++) {
+            int l = label[cx];
+            down[cx] = rng.coin();
+            if (down[cx]) pick[l] = -2; // set already has a way down
+            else if (pick[l] != -2) {
+                seen[l]++;
+                if (rng.below(seen[l]) == 0) pick[l] = cx;
+            }
+        }
+        for (int cx = 0; cx < cellsW; cx++) {
+            if (pick[label[cx]] == cx) down[cx] = 1;
+            if (down[cx]) setRowBit(wallRow, 2 * cx + 1, false);
+            else label[cx] = -1;
+        }
+    }
+
+    emit(sink, cellRow);
+    emit(sink, wallRow); // all walls on the last row: bottom border
+}
+
+long long clampStreamHeight(long long gridHeight) {
+    if (gridHeight < MIN_MAZE_SIZE) gridHeight = MIN_MAZE_SIZE;
+    if (gridHeight % 2 == 0) gridHeight++;
+    return gridHeight;
+}
+
+void generateEllerStream(int gridWidth, long long gridHeight, MazeRowSink& sink, uint64_t seed) {
+    long long cellRows = (clampStreamHeight(gridHeight) - 1) / 2;
+
+    EllerStream eller;
+    eller.begin(gridWidth, sink, seed);
+    for (long long r = 0; r < cellRows; r++) eller.nextRow(sink, r == cellRows - 1);
+}
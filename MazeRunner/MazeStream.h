@@ -0,0 +1,98 @@
+#pragma once
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+#include <vector>
+#include "Maze.h"
+#include "Rng.h"
+
+// -------------------- ROW SINKS --------------------
+// Receives finished grid rows from a streaming generator, top to bottom.
+// Rows are packed like Maze::row(): bit x of word x/64 set means wall, and
+// padding bits past the right edge are set.
+class MazeRowSink {
+public:
+    virtual ~MazeRowSink() {}
+    virtual void writeRow(const uint64_t* bits, int width) = 0;
+};
+
+// Fills a Maze from the top (the maze must already have the right size)
+class MazeFillSink : public MazeRowSink {
+public:
+    explicit MazeFillSink(Maze& m) : maze(m) {}
+    void writeRow(const uint64_t* bits, int width) override;
+private:
+    Maze& maze;
+    int nextY = 0;
+};
+
+// Writes rows as lines of '0'/'1', the same row format as the save file
+class TextRowSink : public MazeRowSink {
+public:
+    explicit TextRowSink(std::ostream& o) : out(o) {}
+    void writeRow(const uint64_t* bits, int width) override;
+private:
+    std::ostream& out;
+    std::vector<char> line;
+};
+
+// Fixed number of rows the game can scroll through while a generator thread
+// keeps producing. writeRow blocks while the buffer is full until the reader
+// releases rows it has scrolled past.
+class RowRingBuffer : public MazeRowSink {
+public:
+    RowRingBuffer(int width, int capacityRows);
+    void writeRow(const uint64_t* bits, int width) override;
+
+    // Reader side. Rows are numbered from 0 for the whole stream.
+    long long firstRow();          // oldest row still kept
+    long long rowsWritten();       // one past the newest row
+    bool waitForRow(long long y);  // blocks until row y exists (false if closed first)
+    bool isWall(int x, long long y); // y must be in [firstRow, rowsWritten)
+    bool readRow(long long y, uint64_t* bits); // copies row y, packed like Maze::row(); false if not kept
+    void releaseBefore(long long y); // the reader no longer needs rows < y
+    void close();                    // wakes everybody, writes are dropped
+
+private:
+    int width, rowWords, capacity;
+    std::vector<uint64_t> rows;
+    long long first = 0, written = 0;
+    bool closed = false;
+    std::mutex lock;
+    std::condition_variable changed;
+};
+
+// -------------------- STREAMING ELLER --------------------
+// Eller's algorithm one cell row at a time. State is only the current row's
+// set labels plus two packed grid rows, so memory is O(width) no matter how
+// many rows are produced. Each cell row emits two grid rows: the row of cells
+// (with east passages) and the wall row under it (with south passages).
+class EllerStream {
+public:
+    // gridWidth is clamped like Maze widths; writes the top border row
+    void begin(int gridWidth, MazeRowSink& sink, uint64_t seed);
+    // lastRow joins every set and closes the bottom border
+    void nextRow(MazeRowSink& sink, bool lastRow);
+
+    int gridWidth() const { return width; }
+    long long gridRowsWritten() const { return rowsOut; }
+
+private:
+    int width = 0, cellsW = 0, rowWords = 0;
+    long long rowsOut = 0;
+    Rng rng;
+    std::vector<int> label, parent, seen, pick;
+    std::vector<unsigned char> used, down;
+    std::vector<uint64_t> cellRow, wallRow;
+
+    void emit(MazeRowSink& sink, std::vector<uint64_t>& row);
+};
+
+// Stream heights have no upper limit, otherwise they follow clampMazeSize:
+// at least MIN_MAZE_SIZE and odd (an even height gets one more row)
+long long clampStreamHeight(long long gridHeight);
+
+// Streams a whole gridWidth x gridHeight maze into the sink (both sizes
+// clamped first, so an even height gives height + 1 rows)
+void generateEllerStream(int gridWidth, long long gridHeight, MazeRowSink& sink, uint64_t seed);
@@ -0,0 +1,319 @@
+#include "MazeSwarm.h"
+#include <algorithm>
+#include <cstdlib>
+#include "Rng.h"
+
+using namespace std;
+
+// -------------------- FLOW FIELD --------------------
+// BFS wave from the queued cell: lowers every neighbour that can do
+// better than it has, up to value limit
+void FlowField::spread(int limit) {
+    int step[4] = { -width, width, -1, 1 };
+    for (size_t head = 0; head < queue.size(); head++) {
+        int c = queue[head];
+        int next = v[c] + 1;
+        if (next > limit) break;
+        for (int k = 0; k < 4; k++) {
+            int n = c + step[k];
+            // walls and cut-off cells hold UNREACHED and are never lowered
+            if (v[n] <= next || v[n] == UNREACHED) continue;
+            v[n] = next;
+            queue.push_back(n);
+        }
+    }
+    touched = (long long)queue.size();
+}
+
+void FlowField::reset(const Maze& maze, int x, int y) {
+    width = maze.width;
+    height = maze.height;
+    tx = x; ty = y;
+    moves = 0;
+    refreshing = false;
+    // open cells start "far" (one below UNREACHED), walls stay UNREACHED;
+    // the outer ring is left out so neighbours never need a bounds check
+    v.assign((size_t)width * height, UNREACHED);
+    if (lost.size() < v.size()) lost.assign(v.size(), 0); // wallsChanged scratch, sized here and not mid-match
+    for (int yy = 1; yy < height - 1; yy++)
+        for (int xx = 1; xx < width - 1; xx++)
+            if (maze.isOpen(xx, yy)) v[(size_t)yy * width + xx] = UNREACHED - 1;
+    queue.clear();
+    if ((unsigned)x >= (unsigned)width || (unsigned)y >= (unsigned)height || v[(size_t)y * width + x] == UNREACHED) return;
+    v[(size_t)y * width + x] = 0;
+    queue.push_back(y * width + x);
+    spread(UNREACHED - 2);
+    // cells the BFS never got to are cut off from the player
+    for (int& value : v)
+        if (value == UNREACHED - 1) value = UNREACHED;
+}
+
+void FlowField::moveTarget(const Maze& maze, int x, int y) {
+    if (x == tx && y == ty && maze.width == width && maze.height == height) { touched = 0; return; }
+    // a refresh that wall edits kept cancelling ends in a plain reset
+    if (maze.width != width || maze.height != height || abs(x - tx) + abs(y - ty) != 1 ||
+        (unsigned)x >= (unsigned)width || (unsigned)y >= (unsigned)height ||
+        v[(size_t)y * width + x] == UNREACHED || moves >= 4 * FLOW_TRAIL_MOVES) {
+        reset(maze, x, y);
+        return;
+    }
+    int c = y * width + x;
+    stepTo(c);
+    if (refreshing) {
+        freshTrail.push_back(c);
+        if (advanceRefresh(maze, (long long)width * height / FLOW_REFRESH_SLICES + 1)) finishRefresh();
+    }
+    else if (moves >= FLOW_TRAIL_MOVES) {
+        refreshing = true;
+        refreshPhase = 0;
+        refreshRow = 0;
+        freshX = x; freshY = y;
+        freshTrail.clear();
+    }
+}
+
+void FlowField::stepTo(int c) {
+    tx = c % width; ty = c / width;
+    moves++;
+    v[c] = -moves;
+    queue.clear();
+    queue.push_back(c);
+    spread(-moves + FLOW_UPDATE_RADIUS);
+}
+
+// -------------------- TRAIL REFRESH --------------------
+// The same work as reset() into fresh, about budget cells per call
+bool FlowField::advanceRefresh(const Maze& maze, long long budget) {
+    int step[4] = { -width, width, -1, 1 };
+    while (budget > 0) {
+        if (refreshPhase == 0) {
+            if (refreshRow == 0) fresh.resize(v.size());
+            if (refreshRow == height) {
+                int start = freshY * width + freshX;
+                fresh[start] = 0;
+                freshQueue.clear();
+                freshQueue.push_back(start);
+                freshHead = 0;
+                refreshPhase = 1;
+                continue;
+            }
+            int y = refreshRow++;
+            int* row = &fresh[(size_t)y * width];
+            for (int x = 0; x < width; x++)
+                row[x] = (y > 0 && y < height - 1 && x > 0 && x < width - 1 && maze.isOpen(x, y)) ? UNREACHED - 1 : UNREACHED;
+            budget -= width;
+        }
+        else if (refreshPhase == 1) {
+            if (freshHead == freshQueue.size()) { refreshPhase = 2; refreshRow = 0; continue; }
+            int c = freshQueue[freshHead++];
+            int next = fresh[c] + 1;
+            for (int k = 0; k < 4; k++) {
+                int n = c + step[k];
+                if (fresh[n] <= next || fresh[n] == UNREACHED) continue;
+                fresh[n] = next;
+                freshQueue.push_back(n);
+            }
+            budget--;
+        }
+        else {
+            if (refreshRow == height) return true;
+            int* row = &fresh[(size_t)(refreshRow++) * width];
+            for (int x = 0; x < width; x++)
+                if (row[x] == UNREACHED - 1) row[x] = UNREACHED;
+            budget -= width;
+        }
+    }
+    return false;
+}
+
+// The fresh field starts where the player was when the refresh began; the
+// steps since then go through the incremental path again
+void FlowField::finishRefresh() {
+    swap(v, fresh);
+    refreshing = false;
+    moves = 0;
+    tx = freshX; ty = freshY;
+    for (int c : freshTrail) stepTo(c);
+}
+
+// Pass 1 of wallsChanged: closed cells, then every cell whose lower
+// neighbours all dropped, into dropped / lost. False (and nothing marked)
+// past limit cells.
+bool FlowField::dropCut(const Maze& maze, const vector<int>& changed, long long limit) {
+    size_t cells = v.size();
+    int target = ty * width + tx;
+    int step[4] = { -width, width, -1, 1 };
+    if (lost.size() < cells) lost.assign(cells, 0);
+    dropped.clear();
+    for (int c : changed) {
+        int x = c % width, y = c / width;
+        // the outer ring always stays UNREACHED
+        if (x <= 0 || y <= 0 || x >= width - 1 || y >= height - 1 || maze.isOpen(x, y) || v[c] == UNREACHED || lost[c]) continue;
+        lost[c] = 1;
+        dropped.push_back(c);
+    }
+    for (size_t head = 0; head < dropped.size(); head++) {
+        int c = dropped[head];
+        for (int k = 0; k < 4; k++) {
+            int n = c + step[k];
+            if (lost[n] || v[n] == UNREACHED || v[n] <= v[c] || n == target) continue;
+            bool supported = false;
+            for (int j = 0; j < 4 && !supported; j++) supported = !lost[n + step[j]] && v[n + step[j]] < v[n];
+            if (supported) continue;
+            lost[n] = 1;
+            dropped.push_back(n);
+        }
+        if ((long long)dropped.size() > limit) {
+            for (int d : dropped) lost[d] = 0;
+            dropped.clear();
+            return false;
+        }
+    }
+    return true;
+}
+
+bool FlowField::repairFits(const Maze& maze, const vector<int>& changed, long long limit) {
+    if (maze.width != width || maze.height != height) return false;
+    bool fits = dropCut(maze, changed, limit);
+    for (int d : dropped) lost[d] = 0;
+    return fits;
+}
+
+// Same two passes as FieldRepair, on trail values: a cell is held up by
+// any neighbour with a lower value, not just by one exactly one lower
+void FlowField::wallsChanged(const Maze& maze, const vector<int>& changed) {
+    refreshing = false; // whatever it built may predate these walls
+    if (maze.width != width || maze.height != height ||
+        !dropCut(maze, changed, (long long)(v.size() / REPAIR_REBUILD_DIVISOR))) {
+        reset(maze, tx, ty);
+        return;
+    }
+    int step[4] = { -width, width, -1, 1 };
+    queue.clear();
+    // closed cells become walls, the rest "far" until the wave gets there
+    for (int c : dropped) {
+        lost[c] = 0;
+        v[c] = maze.isOpen(c % width, c / width) ? UNREACHED - 1 : UNREACHED;
+    }
+    for (int c : changed) {
+        int x = c % width, y = c / width;
+        if (x > 0 && y > 0 && x < width - 1 && y < height - 1 && maze.isOpen(x, y) && v[c] == UNREACHED) { v[c] = UNREACHED - 1; dropped.push_back(c); }
+    }
+
+    // far cells take the best settled neighbour, lowest first; the wave
+    // settles the rest and lowers up to FLOW_UPDATE_RADIUS^2 cells that a
+    // new opening brings closer (optional, every value stays a real walk)
+    seeds.clear();
+    for (int c : dropped) {
+        if (v[c] != UNREACHED - 1) continue;
+        int best = UNREACHED;
+        for (int k = 0; k < 4; k++) best = min(best, v[c + step[k]]);
+        if (best < UNREACHED - 1) seeds.push_back({ best + 1, c });
+    }
+    sort(seeds.begin(), seeds.end(), [](const Seed& a, const Seed& b) { return a.value < b.value; });
+    long long lowered = 0, settled = 0;
+    size_t head = 0, next = 0;
+    while (true) {
+        int c;
+        if (head < queue.size() && (next == seeds.size() || v[queue[head]] <= seeds[next].value)) c = queue[head++];
+        else if (next < seeds.size()) {
+            c = seeds[next].cell;
+            int value = seeds[next++].value;
+            if (v[c] <= value) continue; // reached sooner by the wave
+            v[c] = value;
+        }
+        else break;
+        settled++;
+        int d = v[c] + 1;
+        for (int k = 0; k < 4; k++) {
+            int n = c + step[k];
+            if (v[n] <= d) continue;
+            if (v[n] == UNREACHED) {
+                // a wall, or an open cell that was cut off until an opening
+                // joined it: the whole pocket comes in through the wave
+                int x = n % width, y = n / width;
+                if (x <= 0 || y <= 0 || x >= width - 1 || y >= height - 1 || !maze.isOpen(x, y)) continue;
+            }
+            else if (v[n] != UNREACHED - 1 && lowered++ >= (long long)FLOW_UPDATE_RADIUS * FLOW_UPDATE_RADIUS) continue;
+            v[n] = d;
+            queue.push_back(n);
+        }
+    }
+    // far cells nothing reached are cut off
+    for (int c : dropped)
+        if (v[c] == UNREACHED - 1) v[c] = UNREACHED;
+    touched = (long long)dropped.size() + settled;
+}
+
+int FlowField::distance(int x, int y) const {
+    if ((unsigned)x >= (unsigned)width || (unsigned)y >= (unsigned)height) return -1;
+    return distanceAt(y * width + x);
+}
+
+int FlowField::nextCell(int cell) const {
+    if (v[cell] == UNREACHED || v[cell] == -moves) return -1;
+    int best = cell;
+    if (v[cell - width] < v[best]) best = cell - width;
+    if (v[cell + width] < v[best]) best = cell + width;
+    if (v[cell - 1] < v[best]) best = cell - 1;
+    if (v[cell + 1] < v[best]) best = cell + 1;
+    return best == cell ? -1 : best;
+}
+
+// -------------------- SWARM --------------------
+void Swarm::spawn(const Maze& maze, const FlowField& from, int count, int minDistance, uint64_t seed) {
+    width = maze.width;
+    enemies.clear();
+    Rng rng(seed);
+    long long cells = (long long)maze.width * maze.height;
+    // give up on the distance rule after plenty of tries (tiny boards)
+    for (long long tries = 0; (int)enemies.size() < count && tries < 64LL * count + cells; tries++) {
+        int x = (int)rng.below(maze.width), y = (int)rng.below(maze.height);
+        if (!maze.isOpen(x, y)) continue;
+        int d = from.distance(x, y);
+        if (d < 0 || (d < minDistance && tries < 32LL * count)) continue;
+        enemies.push_back(y * width + x);
+    }
+    phase = 0;
+}
+
+void Swarm::leaveWalls(const Maze& maze) {
+    const int dx[4] = { 0, 0, -1, 1 };
+    const int dy[4] = { -1, 1, 0, 0 };
+    for (int& c : enemies) {
+        int x = c % width, y = c / width;
+        if (maze.isOpen(x, y)) continue;
+        for (int k = 0; k < 4; k++)
+            if (maze.isOpen(x + dx[k], y + dy[k])) { c = (y + dy[k]) * width + x + dx[k]; break; }
+    }
+}
+
+unsigned Swarm::tick(const FlowField* fields, int fieldCount, unsigned hunted) {
+    unsigned caught = 0;
+    if (hunted == 0 || moveTicks <= 0) return caught;
+    int count = (int)enemies.size();
+    int targetCell[2] = { -1, -1 };
+    for (int f = 0; f < fieldCount && f < 2; f++)
+        if (hunted & (1u << f)) targetCell[f] = fields[f].targetY() * width + fields[f].targetX();
+
+    for (int i = phase; i < count; i += moveTicks) {
+        int c = enemies[i];
+        // chase whoever is nearer along its field
+        int best = -1, bestDist = 0;
+        for (int f = 0; f < fieldCount && f < 2; f++) {
+            if (!(hunted & (1u << f))) continue;
+            int d = fields[f].distanceAt(c);
+            if (d >= 0 && (best < 0 || d < bestDist)) { best = f; bestDist = d; }
+        }
+        if (best < 0) continue;
+        int n = fields[best].nextCell(c);
+        if (n >= 0) enemies[i] = n;
+    }
+    // resting enemies catch a player walking into them too
+    for (int i = 0; i < count; i++) {
+        if (enemies[i] == targetCell[0]) caught |= 1u;
+        if (enemies[i] == targetCell[1]) caught |= 2u;
+    }
+    phase = (phase + 1) % moveTicks;
+    return caught;
+}
@@ -0,0 +1,118 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "Maze.h"
+#include "MazeRepair.h"
+
+// -------------------- FLOW FIELD --------------------
+// Shared "way to the player" field for any number of chasers. A full BFS
+// from the player is only run on reset; after that each step of the
+// player seeds the new cell with a lower value than anything before it and
+// re-propagates from there, at most FLOW_UPDATE_RADIUS steps out, so an
+// update touches only cells near the player that got closer.
+//
+// Every value is the length of a real walk to some cell of the player's
+// trail, minus how many steps ago the player was there, and every cell but
+// the player's has a strictly lower neighbour. Stepping to the lowest
+// neighbour therefore always ends on the player: near the player along a
+// shortest path, farther out towards where the player was and then along
+// its trail. After FLOW_TRAIL_MOVES steps the far part is refreshed without
+// a frame-sized BFS: a fresh field is built a 1/FLOW_REFRESH_SLICES slice of
+// the board per step, the steps taken meanwhile are replayed on it, and it
+// takes over.
+const int FLOW_UPDATE_RADIUS = 64;
+const int FLOW_TRAIL_MOVES = 256;
+const int FLOW_REFRESH_SLICES = 32;
+
+class FlowField {
+public:
+    // Full BFS from (x, y)
+    void reset(const Maze& maze, int x, int y);
+
+    // The player is now at (x, y). One step away: incremental; same cell:
+    // nothing; anything else (respawn, jump): reset. Call it for every step,
+    // not once per tick, or two steps in one tick cost a reset.
+    void moveTarget(const Maze& maze, int x, int y);
+
+    // Walls at the grid indices in changed flipped (the player's cell stays
+    // open). Cells that lost every lower neighbour drop out and are settled
+    // again from the cells around them, new openings join in along with any
+    // cut-off pocket they reach; only when more than 1/REPAIR_REBUILD_DIVISOR
+    // of the board would drop is it a reset.
+    void wallsChanged(const Maze& maze, const std::vector<int>& changed);
+
+    // Would wallsChanged drop at most limit cells? Leaves the field alone.
+    bool repairFits(const Maze& maze, const std::vector<int>& changed, long long limit);
+
+    // Steps to the player along the field (exact after a reset, never
+    // shorter than the real distance), -1 on walls / cut off cells
+    int distance(int x, int y) const;
+    int distanceAt(int cell) const { return v[cell] == UNREACHED ? -1 : v[cell] + moves; }
+
+    // Lowest neighbour by grid index, -1 on the player's cell
+    int nextCell(int cell) const;
+
+    int targetX() const { return tx; }
+    int targetY() const { return ty; }
+    long long lastTouched() const { return touched; } // cells lowered by the last update or reset
+    size_t memoryBytes() const {
+        return (v.capacity() + queue.capacity() + dropped.capacity() + fresh.capacity() + freshQueue.capacity() + freshTrail.capacity()) * sizeof(int) +
+            lost.capacity() + seeds.capacity() * sizeof(Seed);
+    }
+
+private:
+    static constexpr int UNREACHED = INT32_MAX;
+    int width = 0, height = 0;
+    int tx = -1, ty = -1, moves = 0;
+    std::vector<int> v;
+    std::vector<int> queue;
+    long long touched = 0;
+    std::vector<uint8_t> lost;      // wallsChanged scratch
+    std::vector<int> dropped;
+    struct Seed { int value, cell; };
+    std::vector<Seed> seeds;
+
+    // trail refresh: rows set up, BFS from (freshX, freshY), then the cells
+    // it never reached cut off; freshTrail holds the steps taken since
+    bool refreshing = false;
+    int refreshPhase = 0, refreshRow = 0, freshX = -1, freshY = -1;
+    std::vector<int> fresh, freshQueue, freshTrail;
+    size_t freshHead = 0;
+
+    void spread(int limit);
+    void stepTo(int c);
+    bool advanceRefresh(const Maze& maze, long long budget); // true once the fresh field is done
+    void finishRefresh();
+    bool dropCut(const Maze& maze, const std::vector<int>& changed, long long limit);
+};
+
+// -------------------- SWARM --------------------
+// Enemies as a flat array of grid indices. Each tick a fixed slice of them
+// (one in moveTicks, by index) steps down the field of the nearer hunted
+// player, so a tick reads a few field values per moving enemy plus one
+// compare per enemy for catches.
+class Swarm {
+public:
+    // count enemies on random open cells at least minDistance steps from
+    // the first field's player
+    void spawn(const Maze& maze, const FlowField& from, int count, int minDistance, uint64_t seed);
+    void clear() { enemies.clear(); }
+
+    // After walls moved: enemies left standing in a wall step to an open
+    // neighbour
+    void leaveWalls(const Maze& maze);
+
+    // hunted: bit i set = fields[i]'s player can be chased. Returns the
+    // bits of the players that an enemy stands on after this tick.
+    unsigned tick(const FlowField* fields, int fieldCount, unsigned hunted);
+
+    int moveTicks = 10;     // ticks per enemy step (60 ticks per second)
+
+    int size() const { return (int)enemies.size(); }
+    int cellOf(int i) const { return enemies[i]; }
+
+private:
+    std::vector<int> enemies;
+    int width = 0;
+    int phase = 0;
+};
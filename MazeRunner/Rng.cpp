@@ -0,0 +1,10 @@
+#include "Rng.h"
+#include <chrono>
+#include <random>
+
+uint64_t randomSeed() {
+    std::random_device rd;
+    uint64_t x = ((uint64_t)rd() << 32) ^ rd();
+    x ^= (uint64_t)std::chrono::high_resolution_clock::now().time_since_epoch().count();
+    return Rng::splitmix64(x);
+}
@@ -0,0 +1,59 @@
+#pragma once
+#include <cstdint>
+
+// Small fast PRNG (xoshiro256**) with explicit 64-bit seeds. Same seed, same
+// numbers on every machine. Not thread-safe by design: give every thread its
+// own Rng, e.g. Rng(seed, streamId), instead of sharing one.
+class Rng {
+public:
+    explicit Rng(uint64_t seed = 0, uint64_t stream = 0) { reseed(seed, stream); }
+
+    // splitmix64 expands (seed, stream) into the 256-bit state, so nearby
+    // seeds and stream ids still give unrelated sequences
+    void reseed(uint64_t seed, uint64_t stream = 0) {
+        uint64_t x = seed ^ (stream * 0xD1B54A32D192ED03ull);
+        for (int i = 0; i < 4; i++) s[i] = splitmix64(x);
+    }
+
+    uint64_t next() {
+        uint64_t result = rotl(s[1] * 5, 7) * 9;
+        uint64_t t = s[1] << 17;
+        s[2] ^= s[0]; s[3] ^= s[1]; s[1] ^= s[2]; s[0] ^= s[3];
+        s[2] ^= t;
+        s[3] = rotl(s[3], 45);
+        return result;
+    }
+
+    // Uniform in [0, n) without modulo bias (Lemire's multiply + reject)
+    uint32_t below(uint32_t n) {
+        uint64_t m = (uint64_t)(uint32_t)(next() >> 32) * n;
+        uint32_t low = (uint32_t)m;
+        if (low < n) {
+            uint32_t threshold = (0u - n) % n;
+            while (low < threshold) {
+                m = (uint64_t)(uint32_t)(next() >> 32) * n;
+                low = (uint32_t)m;
+            }
+        }
+        return (uint32_t)(m >> 32);
+    }
+
+    bool coin() { return (next() >> 63) != 0; }
+
+    // New generator for another thread/tile: independent of this one's future
+    Rng split(uint64_t stream) { return Rng(next(), stream); }
+
+    static uint64_t splitmix64(uint64_t& x) {
+        uint64_t z = (x += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+private:
+    uint64_t s[4];
+    static uint64_t rotl(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+};
+
+// Fresh seed for a new match (random_device mixed with the clock)
+uint64_t randomSeed();